@@ -0,0 +1,244 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+#include "convert.h"
+#include "deleter.h"
+
+namespace {
+    constexpr int FRAME_COUNT = 200;
+
+    constexpr int TOLERANCE = 3;
+
+    constexpr long SEED = 42;
+
+    struct Tier {
+        const char *name;
+
+        int cpuFlags;
+    };
+
+    constexpr Tier TIERS[] = {
+            {"scalar", 0},
+            {"sse4", AV_CPU_FLAG_SSE4},
+            {"avx2", AV_CPU_FLAG_SSE4 | AV_CPU_FLAG_AVX2},
+            {"neon", AV_CPU_FLAG_NEON}
+    };
+
+    struct Image {
+        std::vector<uint8_t> planes[3];
+
+        const uint8_t *data[4] = {nullptr, nullptr, nullptr, nullptr};
+
+        int linesize[4] = {0, 0, 0, 0};
+    };
+
+    double measureFramesPerSecond(const std::function<void()> &convert) {
+        convert();
+
+        const auto start = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < FRAME_COUNT; ++i) {
+            convert();
+        }
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        return FRAME_COUNT / elapsed.count();
+    }
+
+    uint8_t pattern(const double x, const double y, const double phase, std::mt19937 &random) {
+        const auto value = 128.0 + 90.0 * std::sin(x * 0.031 + phase) * std::cos(y * 0.017 - phase);
+
+        return static_cast<uint8_t>(std::clamp(value + static_cast<double>(random() % 9) - 4.0, 0.0, 255.0));
+    }
+
+    Image makeImage(const AVPixelFormat srcFormat, const int width, const int height) {
+        const auto chromaWidth = (width + 1) / 2;
+
+        const auto chromaHeight = (height + 1) / 2;
+
+        std::mt19937 random(SEED);
+
+        Image image;
+
+        image.linesize[0] = width;
+
+        image.planes[0].resize(static_cast<size_t>(width) * height);
+
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                image.planes[0][static_cast<size_t>(y) * width + x] = pattern(x, y, 0.0, random);
+            }
+        }
+
+        if (srcFormat == AV_PIX_FMT_NV12) {
+            image.linesize[1] = chromaWidth * 2;
+
+            image.planes[1].resize(static_cast<size_t>(chromaWidth) * 2 * chromaHeight);
+        } else {
+            image.linesize[1] = image.linesize[2] = chromaWidth;
+
+            image.planes[1].resize(static_cast<size_t>(chromaWidth) * chromaHeight);
+
+            image.planes[2].resize(static_cast<size_t>(chromaWidth) * chromaHeight);
+        }
+
+        for (int y = 0; y < chromaHeight; ++y) {
+            for (int x = 0; x < chromaWidth; ++x) {
+                const auto u = pattern(x * 2, y * 2, 1.0, random);
+
+                const auto v = pattern(x * 2, y * 2, 2.0, random);
+
+                if (srcFormat == AV_PIX_FMT_NV12) {
+                    image.planes[1][static_cast<size_t>(y) * image.linesize[1] + x * 2] = u;
+
+                    image.planes[1][static_cast<size_t>(y) * image.linesize[1] + x * 2 + 1] = v;
+                } else {
+                    image.planes[1][static_cast<size_t>(y) * chromaWidth + x] = u;
+
+                    image.planes[2][static_cast<size_t>(y) * chromaWidth + x] = v;
+                }
+            }
+        }
+
+        for (int plane = 0; plane < 3; ++plane) {
+            image.data[plane] = image.planes[plane].empty() ? nullptr : image.planes[plane].data();
+        }
+
+        return image;
+    }
+
+    std::unique_ptr<SwsContext, SwsContextDeleter> makeSwsContext(
+            const AVPixelFormat srcFormat,
+            const int width,
+            const int height,
+            const int flags
+    ) {
+        return std::unique_ptr<SwsContext, SwsContextDeleter>(sws_getContext(
+                width,
+                height,
+                srcFormat,
+                width,
+                height,
+                AV_PIX_FMT_BGRA,
+                flags,
+                nullptr,
+                nullptr,
+                nullptr
+        ));
+    }
+
+    int measureError(const std::vector<uint8_t> &expected, const std::vector<uint8_t> &actual) {
+        int error = 0;
+
+        for (size_t i = 0; i < expected.size(); ++i) {
+            error = std::max(error, std::abs(static_cast<int>(expected[i]) - static_cast<int>(actual[i])));
+        }
+
+        return error;
+    }
+
+    bool benchmark(const AVPixelFormat srcFormat, const int width, const int height) {
+        const auto image = makeImage(srcFormat, width, height);
+
+        const int dstLinesize[4] = {width * 4, 0, 0, 0};
+
+        std::vector<uint8_t> expected(static_cast<size_t>(dstLinesize[0]) * height);
+
+        std::vector<uint8_t> buffer(expected.size());
+
+        uint8_t *expectedData[4] = {expected.data(), nullptr, nullptr, nullptr};
+
+        uint8_t *dst[4] = {buffer.data(), nullptr, nullptr, nullptr};
+
+        const auto referenceContext = makeSwsContext(
+                srcFormat,
+                width,
+                height,
+                SWS_BILINEAR | SWS_FULL_CHR_H_INT | SWS_ACCURATE_RND
+        );
+
+        const auto swsContext = makeSwsContext(srcFormat, width, height, SWS_BILINEAR);
+
+        if (!referenceContext || !swsContext) {
+            std::fprintf(stderr, "Could not allocate sws context\n");
+
+            return false;
+        }
+
+        sws_scale(referenceContext.get(), image.data, image.linesize, 0, height, expectedData, dstLinesize);
+
+        const auto swsFramesPerSecond = measureFramesPerSecond([&] {
+            sws_scale(swsContext.get(), image.data, image.linesize, 0, height, dst, dstLinesize);
+        });
+
+        const auto name = srcFormat == AV_PIX_FMT_NV12 ? "nv12" : "yuv420p";
+
+        std::printf("%-8s %5dx%-5d sws_scale: %8.1f fps\n", name, width, height, swsFramesPerSecond);
+
+        bool isValid = true;
+
+        for (const auto &tier: TIERS) {
+            if ((av_get_cpu_flags() & tier.cpuFlags) != tier.cpuFlags) {
+                continue;
+            }
+
+            ColorConversion::setCpuFlags(tier.cpuFlags);
+
+            const auto convert = [&] {
+                ColorConversion::convertToBgra(image.data, image.linesize, srcFormat, width, height, 0, height,
+                                               buffer.data(), dstLinesize[0]);
+            };
+
+            std::fill(buffer.begin(), buffer.end(), 0);
+
+            convert();
+
+            const auto error = measureError(expected, buffer);
+
+            const auto framesPerSecond = measureFramesPerSecond(convert);
+
+            std::printf(
+                    "%-8s %5dx%-5d %-6s: %8.1f fps  speedup: %.2fx  max error: %d%s\n",
+                    name,
+                    width,
+                    height,
+                    tier.name,
+                    framesPerSecond,
+                    framesPerSecond / swsFramesPerSecond,
+                    error,
+                    error <= TOLERANCE ? "" : "  FAILED"
+            );
+
+            isValid &= error <= TOLERANCE;
+        }
+
+        ColorConversion::setCpuFlags(av_get_cpu_flags());
+
+        return isValid;
+    }
+}
+
+int main() {
+    bool isValid = true;
+
+    for (const auto srcFormat: {AV_PIX_FMT_YUV420P, AV_PIX_FMT_NV12}) {
+        isValid &= benchmark(srcFormat, 1280, 720);
+
+        isValid &= benchmark(srcFormat, 1920, 1080);
+
+        isValid &= benchmark(srcFormat, 3840, 2160);
+    }
+
+    if (!isValid) {
+        std::fprintf(stderr, "ColorConversion output differs from sws_scale\n");
+    }
+
+    return isValid ? 0 : 1;
+}
@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+#include "butterfly.h"
+#include "fft.h"
+
+namespace {
+    constexpr int ITERATION_COUNT = 2000;
+
+    constexpr float TOLERANCE = 1e-5f;
+
+    double measureTransformsPerSecond(const std::function<void()> &transform) {
+        transform();
+
+        const auto start = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < ITERATION_COUNT; ++i) {
+            transform();
+        }
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        return ITERATION_COUNT / elapsed.count();
+    }
+
+    float maxRelativeError(const std::vector<std::complex<float>> &expected,
+                           const std::vector<std::complex<float>> &actual) {
+        float peak = 0.0f, error = 0.0f;
+
+        for (size_t i = 0; i < expected.size(); ++i) {
+            peak = std::max(peak, std::abs(expected[i]));
+
+            error = std::max(error, std::abs(expected[i] - actual[i]));
+        }
+
+        return peak > 0.0f ? error / peak : error;
+    }
+
+    bool benchmark(const size_t size) {
+        std::mt19937 random(42);
+
+        std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+        std::vector<std::complex<float>> input(size);
+
+        for (auto &value: input) {
+            value = {distribution(random), distribution(random)};
+        }
+
+        std::vector<float> realInput(size);
+
+        for (auto &value: realInput) {
+            value = distribution(random);
+        }
+
+        signalsmith::fft::FFT<float> fft(size);
+
+        signalsmith::fft::ModifiedRealFFT<float> realFft(size);
+
+        std::vector<std::complex<float>> scalarForward(size), scalarInverse(size), scalarReal(size / 2);
+
+        std::vector<std::complex<float>> acceleratedForward(size), acceleratedInverse(size), acceleratedReal(size / 2);
+
+        Butterfly::setAccelerated(false);
+
+        fft.fft(input.data(), scalarForward.data());
+
+        fft.ifft(input.data(), scalarInverse.data());
+
+        realFft.fft(realInput.data(), scalarReal.data());
+
+        const auto scalarRate = measureTransformsPerSecond([&] {
+            fft.fft(input.data(), scalarForward.data());
+        });
+
+        Butterfly::setAccelerated(true);
+
+        fft.fft(input.data(), acceleratedForward.data());
+
+        fft.ifft(input.data(), acceleratedInverse.data());
+
+        realFft.fft(realInput.data(), acceleratedReal.data());
+
+        const auto acceleratedRate = measureTransformsPerSecond([&] {
+            fft.fft(input.data(), acceleratedForward.data());
+        });
+
+        const auto error = std::max({
+                                            maxRelativeError(scalarForward, acceleratedForward),
+                                            maxRelativeError(scalarInverse, acceleratedInverse),
+                                            maxRelativeError(scalarReal, acceleratedReal)
+                                    });
+
+        const bool isValid = error <= TOLERANCE;
+
+        std::printf("%6zu: scalar %10.1f/s, accelerated %10.1f/s, speedup %.2fx, max error %.3g%s\n",
+                    size,
+                    scalarRate,
+                    acceleratedRate,
+                    acceleratedRate / scalarRate,
+                    error,
+                    isValid ? "" : " FAILED");
+
+        return isValid;
+    }
+}
+
+int main() {
+    bool isValid = true;
+
+    for (const size_t size: {8, 16, 64, 256, 480, 1024, 1536, 2048, 4096, 5760, 8192}) {
+        isValid = benchmark(size) && isValid;
+    }
+
+    return isValid ? 0 : 1;
+}
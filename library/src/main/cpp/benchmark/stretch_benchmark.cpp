@@ -0,0 +1,104 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "stretch.h"
+#include "workers.h"
+
+namespace {
+    constexpr int SAMPLE_RATE = 48000;
+
+    constexpr int BLOCK_FRAMES = 1024;
+
+    constexpr int BLOCK_COUNT = 400;
+
+    constexpr long SEED = 42;
+
+    double benchmark(const int channels, const double playbackSpeed, const bool isParallel) {
+        signalsmith::stretch::SignalsmithStretch<float> stretch(SEED);
+
+        stretch.presetDefault(channels, SAMPLE_RATE);
+
+        if (isParallel) {
+            using ChannelTask = signalsmith::spectral::STFT<float>::ChannelTask;
+
+            stretch.setParallel([](const int count, const ChannelTask task) {
+                WorkerPool::getShared().run(count, task);
+            });
+        }
+
+        const int outputFrames = static_cast<int>(std::round(BLOCK_FRAMES / playbackSpeed));
+
+        std::mt19937 random(SEED);
+
+        std::uniform_real_distribution<float> distribution(-0.1f, 0.1f);
+
+        std::vector<std::vector<float>> input(channels, std::vector<float>(BLOCK_FRAMES));
+
+        std::vector<std::vector<float>> output(channels, std::vector<float>(outputFrames));
+
+        double checksum = 0.0;
+
+        long frame = 0;
+
+        std::chrono::duration<double> elapsed{0};
+
+        for (int block = 0; block < BLOCK_COUNT; ++block) {
+            for (int channel = 0; channel < channels; ++channel) {
+                for (int i = 0; i < BLOCK_FRAMES; ++i) {
+                    const auto time = static_cast<double>(frame + i) / SAMPLE_RATE;
+
+                    input[channel][i] = static_cast<float>(
+                            0.3 * std::sin(2.0 * M_PI * 220.0 * (channel + 1) * time)
+                    ) + distribution(random);
+                }
+            }
+
+            frame += BLOCK_FRAMES;
+
+            const auto start = std::chrono::steady_clock::now();
+
+            stretch.process(input, BLOCK_FRAMES, output, outputFrames);
+
+            elapsed += std::chrono::steady_clock::now() - start;
+
+            for (int channel = 0; channel < channels; ++channel) {
+                for (int i = 0; i < outputFrames; ++i) {
+                    checksum += std::abs(output[channel][i]);
+                }
+            }
+        }
+
+        const double intervals = static_cast<double>(outputFrames) * BLOCK_COUNT / stretch.intervalSamples();
+
+        std::printf("%d channels, speed %.2f, %s: %8.2f us per interval, checksum %.6f\n",
+                    channels,
+                    playbackSpeed,
+                    isParallel ? "parallel" : "serial  ",
+                    elapsed.count() * 1e6 / intervals,
+                    checksum);
+
+        return checksum;
+    }
+}
+
+int main() {
+    bool isValid = true;
+
+    for (const int channels: {1, 2, 6, 8}) {
+        for (const double playbackSpeed: {0.25, 0.75, 1.5, 2.0}) {
+            const auto serialChecksum = benchmark(channels, playbackSpeed, false);
+
+            const auto parallelChecksum = benchmark(channels, playbackSpeed, true);
+
+            if (serialChecksum != parallelChecksum) {
+                std::fprintf(stderr, "Parallel output differs from serial output\n");
+
+                isValid = false;
+            }
+        }
+    }
+
+    return isValid ? 0 : 1;
+}
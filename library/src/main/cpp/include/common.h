@@ -8,6 +8,7 @@
 #include <unordered_map>
 #include "decoder.h"
 #include "hwaccel.h"
+#include "pipeline.h"
 #include "sampler.h"
 
 extern jclass runtimeExceptionClass;
@@ -20,6 +21,8 @@ extern jclass poolExceptionClass;
 
 extern jclass samplerExceptionClass;
 
+extern jclass pipelineExceptionClass;
+
 extern jclass formatClass;
 
 extern jmethodID formatConstructor;
@@ -28,6 +31,10 @@ extern jclass audioFrameClass;
 
 extern jmethodID audioFrameConstructor;
 
+extern jclass audioChunkClass;
+
+extern jmethodID audioChunkConstructor;
+
 extern jclass videoFrameClass;
 
 extern jmethodID videoFrameConstructor;
@@ -36,6 +43,8 @@ extern Decoder *getDecoderPointer(jlong handle);
 
 extern Sampler *getSamplerPointer(jlong handle);
 
+extern AudioPipeline *getAudioPipelinePointer(jlong handle);
+
 inline void handleException(JNIEnv *env, const std::function<void()> &call) {
     try {
         call();
@@ -45,6 +54,8 @@ inline void handleException(JNIEnv *env, const std::function<void()> &call) {
         env->ThrowNew(hardwareAccelerationExceptionClass, e.what());
     } catch (const SamplerException &e) {
         env->ThrowNew(samplerExceptionClass, e.what());
+    } catch (const PipelineException &e) {
+        env->ThrowNew(pipelineExceptionClass, e.what());
     } catch (const std::bad_alloc &e) {
         env->ThrowNew(runtimeExceptionClass, "Memory allocation failed");
     } catch (const std::exception &e) {
@@ -64,6 +75,8 @@ inline T handleException(JNIEnv *env, const std::function<T()> &call, T defaultV
         env->ThrowNew(hardwareAccelerationExceptionClass, e.what());
     } catch (const SamplerException &e) {
         env->ThrowNew(samplerExceptionClass, e.what());
+    } catch (const PipelineException &e) {
+        env->ThrowNew(pipelineExceptionClass, e.what());
     } catch (const std::bad_alloc &e) {
         env->ThrowNew(runtimeExceptionClass, "Memory allocation failed");
     } catch (const std::exception &e) {
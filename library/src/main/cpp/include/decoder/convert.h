@@ -0,0 +1,69 @@
+#ifndef KLARITY_DECODER_CONVERT_H
+#define KLARITY_DECODER_CONVERT_H
+
+#include <cstdint>
+
+extern "C" {
+#include <libavutil/cpu.h>
+#include <libavutil/pixfmt.h>
+}
+
+class ColorConversion {
+private:
+    using RowFunction = void (*)(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *dst, int width);
+
+    using PlaneChromaFunction = void (*)(
+            const uint8_t *near,
+            const uint8_t *far,
+            int chromaWidth,
+            uint16_t *sums,
+            uint8_t *dst
+    );
+
+    using NV12ChromaFunction = void (*)(
+            const uint8_t *near,
+            const uint8_t *far,
+            int chromaWidth,
+            uint16_t *uSums,
+            uint16_t *vSums,
+            uint8_t *u,
+            uint8_t *v
+    );
+
+    struct Kernels {
+        RowFunction row;
+
+        PlaneChromaFunction planeChroma;
+
+        NV12ChromaFunction nv12Chroma;
+    };
+
+#if defined(KLARITY_BENCHMARK)
+    static Kernels kernels;
+#else
+    static const Kernels kernels;
+#endif
+
+    static Kernels selectKernels(int cpuFlags);
+
+public:
+#if defined(KLARITY_BENCHMARK)
+    static void setCpuFlags(int cpuFlags);
+#endif
+
+    static bool isSupported(AVPixelFormat srcFormat, AVPixelFormat dstFormat);
+
+    static void convertToBgra(
+            const uint8_t *const src[],
+            const int srcLinesize[],
+            AVPixelFormat srcFormat,
+            int width,
+            int height,
+            int rowBegin,
+            int rowEnd,
+            uint8_t *dst,
+            int dstLinesize
+    );
+};
+
+#endif //KLARITY_DECODER_CONVERT_H
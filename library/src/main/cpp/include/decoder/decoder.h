@@ -1,41 +1,77 @@
 #ifndef KLARITY_DECODER_DECODER_H
 #define KLARITY_DECODER_DECODER_H
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
 #include <memory>
 #include <mutex>
+#include <numeric>
 #include <optional>
 #include <shared_mutex>
 #include <string>
+#include <thread>
+#include "convert.h"
 #include "deleter.h"
 #include "exception.h"
 #include "format.h"
 #include "frame.h"
 #include "hwaccel.h"
+#include "index.h"
+#include "ring.h"
+#include "threading.h"
+#include "workers.h"
 
 extern "C" {
 #include <libavcodec/avcodec.h>
 #include <libavformat/avformat.h>
 #include <libavutil/imgutils.h>
+#include <libavutil/pixdesc.h>
 }
 
 class Decoder {
 private:
     std::shared_mutex mutex;
 
-    const int THREAD_COUNT = 2;
+    static inline std::atomic<int> activeVideoDecoders{0};
 
-    const AVSampleFormat targetSampleFormat = AV_SAMPLE_FMT_FLT;
+    bool isActiveVideoDecoder = false;
 
-    const AVPixelFormat targetPixelFormat = AV_PIX_FMT_BGRA;
+    const int MAX_AUDIO_THREADS = 2;
+
+    const int MAX_VIDEO_THREADS = 16;
+
+    const size_t MAX_QUEUED_PACKETS = 512;
+
+    const int MIN_AUDIO_BUFFER_SAMPLES = 16384;
+
+    const int MAX_SEEK_SLACK_PACKETS = 16;
+
+    AVSampleFormat targetSampleFormat = AV_SAMPLE_FMT_FLT;
+
+    AVPixelFormat targetPixelFormat = AV_PIX_FMT_BGRA;
 
     const int swsFlags = SWS_BILINEAR;
 
+    const int64_t MIN_BAND_PIXELS = 1280 * 720;
+
+    const int MIN_BAND_HEIGHT = 64;
+
     int swsWidth = -1;
 
     int swsHeight = -1;
 
     AVPixelFormat swsPixelFormat = AV_PIX_FMT_NONE;
 
+    int outputWidth = 0;
+
+    int outputHeight = 0;
+
+    std::shared_ptr<KeyframeIndex> keyframeIndex;
+
     std::unique_ptr<AVFormatContext, AVFormatContextDeleter> formatContext;
 
     std::unique_ptr<AVCodecContext, AVCodecContextDeleter> audioCodecContext;
@@ -54,16 +90,58 @@ private:
 
     std::unique_ptr<SwsContext, SwsContextDeleter> swsContext;
 
+    std::vector<std::unique_ptr<SwsContext, SwsContextDeleter>> swsBandContexts;
+
+    int swsBandWidth = -1;
+
+    int swsBandHeight = -1;
+
+    AVPixelFormat swsBandPixelFormat = AV_PIX_FMT_NONE;
+
     std::unique_ptr<AVPacket, AVPacketDeleter> packet;
 
+    std::deque<std::unique_ptr<AVPacket, AVPacketDeleter>> audioPackets;
+
+    std::deque<std::unique_ptr<AVPacket, AVPacketDeleter>> videoPackets;
+
+    std::vector<std::unique_ptr<AVPacket, AVPacketDeleter>> sparePackets;
+
     std::unique_ptr<AVFrame, AVFrameDeleter> audioFrame;
 
     std::unique_ptr<AVFrame, AVFrameDeleter> swVideoFrame;
 
     std::unique_ptr<AVFrame, AVFrameDeleter> hwVideoFrame;
 
+    std::unique_ptr<AVFrame, AVFrameDeleter> prerollFrame;
+
     std::vector<uint8_t> audioBuffer;
 
+    std::vector<uint8_t *> audioPlanes;
+
+    int audioFrameCapacity = 0;
+
+    int audioChunkSamples = 0;
+
+    int64_t pendingAudioTimestampMicros = AV_NOPTS_VALUE;
+
+    std::unique_ptr<FrameRing> audioFrames;
+
+    std::unique_ptr<FrameRing> videoFrames;
+
+    std::thread worker;
+
+    std::mutex workerMutex;
+
+    std::condition_variable workerCondition;
+
+    std::atomic<bool> isWorkerStopRequested{false};
+
+    std::atomic<bool> isAudioEndOfStream{false};
+
+    std::atomic<bool> isVideoEndOfStream{false};
+
+    std::exception_ptr workerException;
+
 public:
     static AVPixelFormat _getHardwareAccelerationFormat(
             AVCodecContext *codecContext,
@@ -80,9 +158,77 @@ public:
 
     bool _prepareHardwareAcceleration(uint32_t deviceType);
 
-    int _processAudio();
+    std::deque<std::unique_ptr<AVPacket, AVPacketDeleter>> *_getPacketQueue(int streamIndex);
+
+    void _queuePacket(AVPacket *src);
+
+    bool _readPacket(const AVStream *stream);
 
-    int _processVideo(uint8_t *buffer);
+    void _clearPackets();
+
+    bool _receiveAudioFrame(AVFrame *dst);
+
+    bool _receiveVideoFrame(AVFrame *dst);
+
+    void _runWorker();
+
+    void _startWorker();
+
+    void _stopWorker();
+
+    AVFrame *_awaitFrame(FrameRing &frames, const std::atomic<bool> &isEndOfStream);
+
+    void _releaseFrame(FrameRing &frames);
+
+    void _seekTo(long timestampMicros, bool keyFramesOnly);
+
+    int _getAudioOutputSize();
+
+    int _processAudio(uint8_t *buffer, int capacity);
+
+    bool _decodeAudioFrame(int64_t &timestampMicros);
+
+    int _decodeAudioChunk(uint8_t *buffer, int capacity, int64_t &timestampMicros);
+
+    void _resetAudioConversion();
+
+    uint8_t **_getAudioPlanes(uint8_t *buffer, int stride, int offset);
+
+    void _compactAudioPlanes(uint8_t *buffer, int stride, int samples) const;
+
+    void _updateAudioBufferCapacity();
+
+    void _updateVideoOutputFormat();
+
+    void _setOutputSize(int width, int height);
+
+    KeyframeIndex &_getKeyframeIndex();
+
+    AVFrame *_getPrerollFrame(const AVCodecContext *codecContext);
+
+    int _getAutoThreadCount(const AVCodecContext *codecContext) const;
+
+    void _configureThreading(
+            AVCodecContext *codecContext,
+            const AVCodec *codec,
+            int threadCount,
+            ThreadType threadType,
+            DecodingProfile decodingProfile
+    ) const;
+
+    int _getBandCount(int width, int height) const;
+
+    static void _offsetPlanes(
+            const AVPixFmtDescriptor *descriptor,
+            uint8_t *const data[4],
+            const int linesize[4],
+            int row,
+            uint8_t *planes[4]
+    );
+
+    void _scaleBands(const AVFrame *src, uint8_t *const dst[4], const int dstLinesize[4], int bandCount);
+
+    int _processVideo(uint8_t *buffer, int capacity);
 
 public:
     Decoder(
@@ -91,7 +237,15 @@ public:
             bool findVideoStream,
             bool decodeAudioStream,
             bool decodeVideoStream,
-            const std::vector<uint32_t> &hardwareAccelerationCandidates
+            const std::vector<uint32_t> &hardwareAccelerationCandidates,
+            int readAheadFrames = 0,
+            VideoOutputFormat videoOutputFormat = VideoOutputFormat::BGRA,
+            int threadCount = 0,
+            ThreadType threadType = ThreadType::AUTO,
+            DecodingProfile decodingProfile = DecodingProfile::LATENCY,
+            int outputSampleRate = 0,
+            int outputChannels = 0,
+            AudioOutputFormat audioOutputFormat = AudioOutputFormat::FLT
     );
 
     ~Decoder();
@@ -102,10 +256,31 @@ public:
 
     Format format;
 
+    Format getFormat();
+
+    int getAudioBufferCapacity();
+
     std::optional<AudioFrame> decodeAudio();
 
+    std::optional<AudioChunk> decodeAudio(uint8_t *buffer, int capacity);
+
     std::optional<VideoFrame> decodeVideo(uint8_t *buffer, int capacity);
 
+    std::vector<std::optional<VideoFrame>> decodeThumbnails(
+            const std::vector<int64_t> &timestampsMicros,
+            int width,
+            int height,
+            bool keyFramesOnly,
+            uint8_t *buffer,
+            int capacity
+    );
+
+    void setAudioChunkSize(int samples);
+
+    void setOutputSize(int width, int height);
+
+    std::vector<Keyframe> getKeyframes();
+
     void seekTo(long timestampMicros, bool keyFramesOnly);
 
     void reset();
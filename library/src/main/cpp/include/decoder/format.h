@@ -5,18 +5,35 @@
 
 extern "C" {
 #include <libavutil/hwcontext.h>
+#include <libavutil/pixfmt.h>
+#include <libavutil/samplefmt.h>
 }
 
+enum class AudioOutputFormat {
+    FLT,
+    S16,
+    FLTP
+};
+
+enum class VideoOutputFormat {
+    BGRA,
+    YUV
+};
+
 struct Format {
     std::string location;
     int64_t durationMicros;
     int32_t sampleRate = 0;
     int32_t channels = 0;
+    int audioBufferCapacity = 0;
+    AVSampleFormat audioSampleFormat = AV_SAMPLE_FMT_NONE;
     int32_t width = 0;
     int32_t height = 0;
     double frameRate = 0.0;
     AVHWDeviceType hwDeviceType = AV_HWDEVICE_TYPE_NONE;
     int videoBufferCapacity = 0;
+    AVPixelFormat videoPixelFormat = AV_PIX_FMT_NONE;
+    int videoStrides[4] = {0, 0, 0, 0};
 };
 
 #endif //KLARITY_DECODER_FORMAT_H
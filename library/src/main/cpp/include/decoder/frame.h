@@ -8,9 +8,16 @@ struct AudioFrame {
     int64_t timestampMicros;
 };
 
+struct AudioChunk {
+    int remaining;
+    int64_t timestampMicros;
+};
+
 struct VideoFrame {
     int remaining;
     int64_t timestampMicros;
+    int width;
+    int height;
 };
 
 #endif //KLARITY_DECODER_FRAME_H
\ No newline at end of file
@@ -0,0 +1,73 @@
+#ifndef KLARITY_DECODER_INDEX_H
+#define KLARITY_DECODER_INDEX_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "deleter.h"
+#include "exception.h"
+
+extern "C" {
+#include <libavformat/avformat.h>
+}
+
+struct Keyframe {
+    int64_t timestamp;
+    int64_t timestampMicros;
+    int64_t position;
+    int gopFrames;
+};
+
+class KeyframeIndex {
+private:
+    AVRational timeBase;
+
+    double frameRate;
+
+    bool isScanned = false;
+
+    bool isScanComplete = true;
+
+    std::atomic<bool> isScanCancelled{false};
+
+    mutable std::mutex scanMutex;
+
+    std::condition_variable scanCondition;
+
+    std::thread scanner;
+
+    std::vector<Keyframe> keyframes;
+
+    static int _interruptScan(void *opaque);
+
+    void _append(int64_t timestamp, int64_t position);
+
+    void _estimateGopFrames(int64_t endTimestamp);
+
+    void _buildFromStream(AVStream *stream);
+
+    void _buildFromScan(const std::string &location, int streamIndex);
+
+    void _completeScan();
+
+public:
+    KeyframeIndex(const std::string &location, AVStream *stream, double frameRate);
+
+    ~KeyframeIndex();
+
+    bool isByteSeekable() const;
+
+    std::vector<Keyframe> getKeyframes();
+
+    std::optional<Keyframe> findPreceding(int64_t timestamp) const;
+
+    int getDecodeDistance(const Keyframe &keyframe, int64_t timestamp) const;
+};
+
+#endif //KLARITY_DECODER_INDEX_H
@@ -26,7 +26,15 @@ JNIEXPORT jlong JNICALL Java_io_github_numq_klarity_decoder_NativeDecoder_00024N
         jboolean findVideoStream,
         jboolean decodeAudioStream,
         jboolean decodeVideoStream,
-        jintArray hardwareAccelerationCandidates
+        jintArray hardwareAccelerationCandidates,
+        jint readAheadFrames,
+        jint videoOutputFormat,
+        jint threadCount,
+        jint threadType,
+        jint decodingProfile,
+        jint sampleRate,
+        jint channels,
+        jint audioOutputFormat
 );
 
 JNIEXPORT jobject JNICALL Java_io_github_numq_klarity_decoder_NativeDecoder_00024Native_getFormat(
@@ -41,6 +49,14 @@ JNIEXPORT jobject JNICALL Java_io_github_numq_klarity_decoder_NativeDecoder_0002
         jlong decoderHandle
 );
 
+JNIEXPORT jobject JNICALL Java_io_github_numq_klarity_decoder_NativeDecoder_00024Native_decodeAudioInto(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong decoderHandle,
+        jlong buffer,
+        jint capacity
+);
+
 JNIEXPORT jobject JNICALL Java_io_github_numq_klarity_decoder_NativeDecoder_00024Native_decodeVideo(
         JNIEnv *env,
         jclass thisClass,
@@ -49,6 +65,39 @@ JNIEXPORT jobject JNICALL Java_io_github_numq_klarity_decoder_NativeDecoder_0002
         jint capacity
 );
 
+JNIEXPORT jobjectArray JNICALL Java_io_github_numq_klarity_decoder_NativeDecoder_00024Native_decodeThumbnails(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong decoderHandle,
+        jlongArray timestampsMicros,
+        jint width,
+        jint height,
+        jboolean keyFramesOnly,
+        jlong buffer,
+        jint capacity
+);
+
+JNIEXPORT jlongArray JNICALL Java_io_github_numq_klarity_decoder_NativeDecoder_00024Native_getKeyframes(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong decoderHandle
+);
+
+JNIEXPORT void JNICALL Java_io_github_numq_klarity_decoder_NativeDecoder_00024Native_setAudioChunkSize(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong decoderHandle,
+        jint samples
+);
+
+JNIEXPORT void JNICALL Java_io_github_numq_klarity_decoder_NativeDecoder_00024Native_setOutputSize(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong decoderHandle,
+        jint width,
+        jint height
+);
+
 JNIEXPORT void JNICALL Java_io_github_numq_klarity_decoder_NativeDecoder_00024Native_seekTo(
         JNIEnv *env,
         jclass thisClass,
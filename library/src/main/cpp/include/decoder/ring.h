@@ -0,0 +1,44 @@
+#ifndef KLARITY_DECODER_RING_H
+#define KLARITY_DECODER_RING_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "deleter.h"
+#include "exception.h"
+
+extern "C" {
+#include <libavutil/frame.h>
+}
+
+class FrameRing {
+private:
+    std::vector<std::unique_ptr<AVFrame, AVFrameDeleter>> frames;
+
+    alignas(64) std::atomic<size_t> head{0};
+
+    alignas(64) std::atomic<size_t> tail{0};
+
+public:
+    explicit FrameRing(size_t capacity);
+
+    FrameRing(const FrameRing &) = delete;
+
+    FrameRing &operator=(const FrameRing &) = delete;
+
+    bool isEmpty() const;
+
+    bool isFull() const;
+
+    AVFrame *acquire();
+
+    void publish();
+
+    AVFrame *peek();
+
+    void release();
+
+    void clear();
+};
+
+#endif //KLARITY_DECODER_RING_H
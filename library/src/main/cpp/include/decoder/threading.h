@@ -0,0 +1,16 @@
+#ifndef KLARITY_DECODER_THREADING_H
+#define KLARITY_DECODER_THREADING_H
+
+enum class ThreadType {
+    AUTO,
+    NONE,
+    FRAME,
+    SLICE
+};
+
+enum class DecodingProfile {
+    LATENCY,
+    THROUGHPUT
+};
+
+#endif //KLARITY_DECODER_THREADING_H
@@ -0,0 +1,81 @@
+#ifndef KLARITY_DECODER_WORKERS_H
+#define KLARITY_DECODER_WORKERS_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+class WorkerPool {
+private:
+    using Invoke = void (*)(void *context, int index);
+
+    struct Batch {
+        void *context = nullptr;
+
+        Invoke invoke = nullptr;
+
+        int count = 0;
+
+        std::atomic<int> next{0};
+
+        std::atomic<int> remaining{0};
+
+        std::atomic<int> helpers{0};
+
+        std::mutex mutex;
+
+        std::condition_variable completion;
+
+        std::exception_ptr exception;
+    };
+
+    std::mutex mutex;
+
+    std::condition_variable condition;
+
+    std::vector<Batch *> batches;
+
+    std::vector<std::unique_ptr<Batch>> spareBatches;
+
+    std::vector<std::thread> threads;
+
+    bool isStopRequested = false;
+
+    static void _drain(Batch &batch);
+
+    Batch *_findBatch();
+
+    void _work();
+
+    void _run(int count, void *context, Invoke invoke);
+
+public:
+    explicit WorkerPool(size_t threadCount);
+
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool &) = delete;
+
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    static WorkerPool &getShared();
+
+    int getConcurrency() const;
+
+    template<typename Task>
+    void run(const int count, Task &&task) {
+        using Callable = std::remove_reference_t<Task>;
+
+        _run(count, const_cast<void *>(static_cast<const void *>(std::addressof(task))), [](void *context, int index) {
+            (*static_cast<Callable *>(context))(index);
+        });
+    }
+};
+
+#endif //KLARITY_DECODER_WORKERS_H
@@ -0,0 +1,12 @@
+#ifndef KLARITY_PIPELINE_EXCEPTION_H
+#define KLARITY_PIPELINE_EXCEPTION_H
+
+#include <stdexcept>
+#include <string>
+
+class PipelineException : public std::runtime_error {
+public:
+    explicit PipelineException(const std::string &message) : std::runtime_error(message) {}
+};
+
+#endif //KLARITY_PIPELINE_EXCEPTION_H
@@ -0,0 +1,72 @@
+#include <jni.h>
+#include "common.h"
+#include "pipeline.h"
+
+#ifndef _Included_io_github_numq_klarity_pipeline_NativeAudioPipeline
+#define _Included_io_github_numq_klarity_pipeline_NativeAudioPipeline
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+JNIEXPORT jlong JNICALL Java_io_github_numq_klarity_pipeline_NativeAudioPipeline_00024Native_create(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong decoderHandle,
+        jlong samplerHandle
+);
+
+JNIEXPORT void JNICALL Java_io_github_numq_klarity_pipeline_NativeAudioPipeline_00024Native_start(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong pipelineHandle
+);
+
+JNIEXPORT void JNICALL Java_io_github_numq_klarity_pipeline_NativeAudioPipeline_00024Native_stop(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong pipelineHandle
+);
+
+JNIEXPORT void JNICALL Java_io_github_numq_klarity_pipeline_NativeAudioPipeline_00024Native_seekTo(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong pipelineHandle,
+        jlong timestampMicros
+);
+
+JNIEXPORT void JNICALL Java_io_github_numq_klarity_pipeline_NativeAudioPipeline_00024Native_setVolume(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong pipelineHandle,
+        jfloat volume
+);
+
+JNIEXPORT void JNICALL Java_io_github_numq_klarity_pipeline_NativeAudioPipeline_00024Native_setPlaybackSpeed(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong pipelineHandle,
+        jfloat factor
+);
+
+JNIEXPORT jlong JNICALL Java_io_github_numq_klarity_pipeline_NativeAudioPipeline_00024Native_getTimestampMicros(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong pipelineHandle
+);
+
+JNIEXPORT jboolean JNICALL Java_io_github_numq_klarity_pipeline_NativeAudioPipeline_00024Native_isCompleted(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong pipelineHandle
+);
+
+JNIEXPORT void JNICALL Java_io_github_numq_klarity_pipeline_NativeAudioPipeline_00024Native_delete(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong pipelineHandle
+);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
\ No newline at end of file
@@ -0,0 +1,96 @@
+#ifndef KLARITY_PIPELINE_PIPELINE_H
+#define KLARITY_PIPELINE_PIPELINE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "decoder.h"
+#include "exception.h"
+#include "sampler.h"
+
+class AudioPipeline {
+private:
+    Decoder *decoder;
+
+    Sampler *sampler;
+
+    std::vector<uint8_t> buffer;
+
+    bool isPlanar = false;
+
+    int sampleRate = 0;
+
+    int64_t durationMicros = 0;
+
+    int bytesPerFrame = 0;
+
+    std::thread worker;
+
+    std::mutex mutex;
+
+    std::condition_variable condition;
+
+    bool isPlaying = false;
+
+    bool isBusy = false;
+
+    bool isStopRequested = false;
+
+    std::exception_ptr workerException;
+
+    std::atomic<float> volume{1.0f};
+
+    std::atomic<float> playbackSpeedFactor{1.0f};
+
+    mutable std::mutex clockMutex;
+
+    int64_t clockMicros = 0;
+
+    uint64_t clockFrames = 0;
+
+    int64_t clockLatencyMicros = 0;
+
+    float clockPlaybackSpeedFactor = 1.0f;
+
+    bool isClockAnchored = false;
+
+    std::atomic<bool> isEndOfStream{false};
+
+    void _runWorker();
+
+    void _pump();
+
+    void _pause(std::unique_lock<std::mutex> &lock);
+
+    void _rethrowWorkerException();
+
+    void _resetClock(int64_t timestampMicros);
+
+public:
+    AudioPipeline(Decoder *decoder, Sampler *sampler);
+
+    ~AudioPipeline();
+
+    AudioPipeline(const AudioPipeline &) = delete;
+
+    AudioPipeline &operator=(const AudioPipeline &) = delete;
+
+    void start();
+
+    void stop();
+
+    void seekTo(long timestampMicros);
+
+    void setVolume(float value);
+
+    void setPlaybackSpeed(float factor);
+
+    int64_t getTimestampMicros() const;
+
+    bool isCompleted() const;
+};
+
+#endif //KLARITY_PIPELINE_PIPELINE_H
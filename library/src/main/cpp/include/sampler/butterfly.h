@@ -0,0 +1,64 @@
+#ifndef KLARITY_SAMPLER_BUTTERFLY_H
+#define KLARITY_SAMPLER_BUTTERFLY_H
+
+#include <complex>
+#include <cstddef>
+
+class Butterfly {
+private:
+    using StepFunction = void (*)(
+            std::complex<float> *data,
+            const std::complex<float> *twiddles,
+            size_t stride,
+            size_t outerRepeats
+    );
+
+    struct Kernels {
+        StepFunction radix2Forward;
+
+        StepFunction radix2Inverse;
+
+        StepFunction radix4Forward;
+
+        StepFunction radix4Inverse;
+    };
+
+#if defined(KLARITY_BENCHMARK)
+    static Kernels kernels;
+#else
+    static const Kernels kernels;
+#endif
+
+    static Kernels selectKernels();
+
+    static Kernels scalarKernels();
+
+public:
+    static constexpr size_t MIN_ACCELERATED_STRIDE = 4;
+
+#if defined(KLARITY_BENCHMARK)
+    static void setAccelerated(bool isAccelerated);
+#endif
+
+    template<bool inverse>
+    static void radix2(
+            std::complex<float> *data,
+            const std::complex<float> *twiddles,
+            const size_t stride,
+            const size_t outerRepeats
+    ) {
+        (inverse ? kernels.radix2Inverse : kernels.radix2Forward)(data, twiddles, stride, outerRepeats);
+    }
+
+    template<bool inverse>
+    static void radix4(
+            std::complex<float> *data,
+            const std::complex<float> *twiddles,
+            const size_t stride,
+            const size_t outerRepeats
+    ) {
+        (inverse ? kernels.radix4Inverse : kernels.radix4Forward)(data, twiddles, stride, outerRepeats);
+    }
+};
+
+#endif //KLARITY_SAMPLER_BUTTERFLY_H
@@ -4,10 +4,12 @@
 #define SIGNALSMITH_FFT_V5
 
 #include "./perf.h"
+#include "../butterfly.h"
 
 #include <vector>
 #include <complex>
 #include <cmath>
+#include <type_traits>
 
 namespace signalsmith { namespace fft {
 	/**	@defgroup FFT FFT (complex and real)
@@ -227,6 +229,12 @@ namespace signalsmith { namespace fft {
 		SIGNALSMITH_INLINE void fftStep2(RandomAccessIterator &&origData, const Step &step) {
 			const size_t stride = step.innerRepeats;
 			const complex *origTwiddles = twiddleVector.data() + step.twiddleIndex;
+			if constexpr (std::is_same<V, float>::value && std::is_convertible<RandomAccessIterator, complex *>::value) {
+				if (stride >= Butterfly::MIN_ACCELERATED_STRIDE) {
+					Butterfly::radix2<inverse>(origData, origTwiddles, stride, step.outerRepeats);
+					return;
+				}
+			}
 			for (size_t outerRepeat = 0; outerRepeat < step.outerRepeats; ++outerRepeat) {
 				const complex* twiddles = origTwiddles;
 				for (RandomAccessIterator data = origData; data < origData + stride; ++data) {
@@ -271,6 +279,12 @@ namespace signalsmith { namespace fft {
 		SIGNALSMITH_INLINE void fftStep4(RandomAccessIterator &&origData, const Step &step) {
 			const size_t stride = step.innerRepeats;
 			const complex *origTwiddles = twiddleVector.data() + step.twiddleIndex;
+			if constexpr (std::is_same<V, float>::value && std::is_convertible<RandomAccessIterator, complex *>::value) {
+				if (stride >= Butterfly::MIN_ACCELERATED_STRIDE) {
+					Butterfly::radix4<inverse>(origData, origTwiddles, stride, step.outerRepeats);
+					return;
+				}
+			}
 			
 			for (size_t outerRepeat = 0; outerRepeat < step.outerRepeats; ++outerRepeat) {
 				const complex* twiddles = origTwiddles;
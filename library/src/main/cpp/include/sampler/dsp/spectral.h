@@ -9,6 +9,7 @@
 #include "./delay.h"
 
 #include <cmath>
+#include <functional>
 
 namespace signalsmith {
 namespace spectral {
@@ -206,6 +207,37 @@ namespace spectral {
 		};
 		std::vector<Sample> timeBuffer;
 
+	public:
+		/// Non-owning reference to a per-channel task, only valid during the `parallelFor` call it is passed to
+		struct ChannelTask {
+			void *context;
+			void (*invoke)(void *context, int c);
+			void operator()(int c) const {
+				invoke(context, c);
+			}
+		};
+		using ParallelFor = std::function<void(int, ChannelTask)>;
+	private:
+		ParallelFor parallelFor;
+		// Per-channel FFTs and buffers, so channels can be processed concurrently
+		std::vector<WindowedFFT<Sample>> channelFfts;
+		std::vector<std::vector<Sample>> channelTimeBuffers;
+		void updateChannelFfts() {
+			if (parallelFor) {
+				channelFfts.assign(channels, fft);
+				channelTimeBuffers.assign(channels, std::vector<Sample>(_fftSize));
+			} else {
+				channelFfts.clear();
+				channelTimeBuffers.clear();
+			}
+		}
+		WindowedFFT<Sample> & channelFft(int c) {
+			return parallelFor ? channelFfts[c] : fft;
+		}
+		std::vector<Sample> & channelTimeBuffer(int c) {
+			return parallelFor ? channelTimeBuffers[c] : timeBuffer;
+		}
+
 		void resizeInternal(int newChannels, int windowSize, int newInterval, int historyLength, int zeroPadding) {
 			Super::resize(newChannels,
 				windowSize /* for output summing */
@@ -260,6 +292,28 @@ namespace spectral {
 			for (int i = _windowSize; i < _fftSize; ++i) {
 				window[i] = 0;
 			}
+			updateChannelFfts();
+		}
+
+		/** Spreads per-channel FFTs across `parallelFor(count, task)`, which must call `task(0)` ... `task(count - 1)` (in any order, on any threads) before returning.
+
+		Pass an empty function to go back to processing channels serially. */
+		void setParallel(ParallelFor fn) {
+			parallelFor = fn;
+			updateChannelFfts();
+		}
+		/// Calls `fn(c)` for every channel, concurrently if `.setParallel()` was used
+		template<class Fn>
+		void forEachChannel(Fn &&fn) {
+			if (parallelFor && channels > 1) {
+				using Callable = typename std::remove_reference<Fn>::type;
+				void *context = const_cast<void *>(static_cast<const void *>(&fn));
+				parallelFor(channels, ChannelTask{context, [](void *context, int c) {
+					(*static_cast<Callable *>(context))(c);
+				}});
+			} else {
+				for (int c = 0; c < channels; ++c) fn(c);
+			}
 		}
 
 		using Spectrum = MultiSpectrum;
@@ -324,7 +378,7 @@ namespace spectral {
 				fn(blockIndex);
 
 				auto output = this->view(blockIndex);
-				for (int c = 0; c < channels; ++c) {
+				forEachChannel([&](int c) {
 					auto channel = output[c];
 
 					// Clear out the future sum, a window-length and an interval ahead
@@ -333,11 +387,12 @@ namespace spectral {
 					}
 
 					// Add in the IFFT'd result
-					fft.ifft(spectrum[c], timeBuffer);
+					auto &channelBuffer = channelTimeBuffer(c);
+					channelFft(c).ifft(spectrum[c], channelBuffer);
 					for (int wi = 0; wi < _windowSize; ++wi) {
-						channel[wi] += timeBuffer[wi];
+						channel[wi] += channelBuffer[wi];
 					}
-				}
+				});
 				validUntilIndex += _interval;
 			}
 		}
@@ -356,13 +411,14 @@ namespace spectral {
 		Results can be read/edited using `.spectrum`. */
 		template<class Data>
 		void analyse(Data &&data) {
-			for (int c = 0; c < channels; ++c) {
-				fft.fft(data[c], spectrum[c]);
-			}
+			forEachChannel([&](int c) {
+				channelFft(c).fft(data[c], spectrum[c]);
+			});
 		}
+		/// Analyses a single channel - safe to call concurrently for different channels after `.setParallel()`
 		template<class Data>
 		void analyse(int c, Data &&data) {
-			fft.fft(data, spectrum[c]);
+			channelFft(c).fft(data, spectrum[c]);
 		}
 		/// Analyse without windowing or zero-rotation
 		template<class Data>
@@ -0,0 +1,38 @@
+#ifndef KLARITY_SAMPLER_FIFO_H
+#define KLARITY_SAMPLER_FIFO_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
+#include "exception.h"
+
+class SampleFifo {
+private:
+    std::vector<float> samples;
+
+    alignas(64) std::atomic<size_t> head{0};
+
+    alignas(64) std::atomic<size_t> tail{0};
+
+public:
+    explicit SampleFifo(size_t capacity);
+
+    SampleFifo(const SampleFifo &) = delete;
+
+    SampleFifo &operator=(const SampleFifo &) = delete;
+
+    size_t capacity() const;
+
+    size_t available() const;
+
+    size_t space() const;
+
+    size_t push(const float *src, size_t count);
+
+    size_t pop(float *dst, size_t count);
+
+    void clear();
+};
+
+#endif //KLARITY_SAMPLER_FIFO_H
@@ -0,0 +1,44 @@
+#ifndef KLARITY_SAMPLER_INTERLEAVE_H
+#define KLARITY_SAMPLER_INTERLEAVE_H
+
+#include <cstdint>
+
+extern "C" {
+#include <libavutil/cpu.h>
+}
+
+class Interleave {
+private:
+    using ScaleFunction = void (*)(const float *src, float *dst, int samples, float gain);
+
+    using SplitFunction = void (*)(const float *src, float *left, float *right, int samples);
+
+    using MergeFunction = void (*)(const float *left, const float *right, float *dst, int samples, float gain);
+
+    static ScaleFunction scale;
+
+    static SplitFunction split;
+
+    static MergeFunction merge;
+
+    static ScaleFunction selectScale();
+
+    static SplitFunction selectSplit();
+
+    static MergeFunction selectMerge();
+
+    template<int Channels>
+    static void _deinterleave(const float *src, float *const *dst, int channels, int samples);
+
+    template<int Channels>
+    static void _interleave(const float *const *src, float *dst, int channels, int samples, float gain);
+
+public:
+    static void deinterleave(const float *src, float *const *dst, int channels, int samples);
+
+    static void clamp(const float *const *src, float *const *dst, int channels, int samples);
+
+    static void interleave(const float *const *src, float *dst, int channels, int samples, float gain);
+};
+
+#endif //KLARITY_SAMPLER_INTERLEAVE_H
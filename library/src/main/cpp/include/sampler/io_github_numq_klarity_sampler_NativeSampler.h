@@ -15,7 +15,14 @@ JNIEXPORT jlong JNICALL Java_io_github_numq_klarity_sampler_NativeSampler_00024N
         JNIEnv *env,
         jclass thisClass,
         jint sampleRate,
-        jint channels
+        jint channels,
+        jint bufferFrames,
+        jint stretchQuality,
+        jint blockSamples,
+        jint intervalSamples,
+        jint speedMode,
+        jint resamplingInterpolator,
+        jint stretchThreadCount
 );
 
 JNIEXPORT jlong JNICALL Java_io_github_numq_klarity_sampler_NativeSampler_00024Native_start(
@@ -33,6 +40,15 @@ JNIEXPORT void JNICALL Java_io_github_numq_klarity_sampler_NativeSampler_00024Na
         jfloat playbackSpeedFactor
 );
 
+JNIEXPORT void JNICALL Java_io_github_numq_klarity_sampler_NativeSampler_00024Native_writePlanar(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong samplerHandle,
+        jbyteArray bytes,
+        jfloat volume,
+        jfloat playbackSpeedFactor
+);
+
 JNIEXPORT void JNICALL Java_io_github_numq_klarity_sampler_NativeSampler_00024Native_stop(
         JNIEnv *env,
         jclass thisClass,
@@ -53,6 +69,18 @@ JNIEXPORT void JNICALL Java_io_github_numq_klarity_sampler_NativeSampler_00024Na
         jfloat playbackSpeedFactor
 );
 
+JNIEXPORT jlong JNICALL Java_io_github_numq_klarity_sampler_NativeSampler_00024Native_getLatency(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong samplerHandle
+);
+
+JNIEXPORT jlong JNICALL Java_io_github_numq_klarity_sampler_NativeSampler_00024Native_getUnderrunCount(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong samplerHandle
+);
+
 JNIEXPORT void JNICALL Java_io_github_numq_klarity_sampler_NativeSampler_00024Native_delete(
         JNIEnv *env,
         jclass thisClass,
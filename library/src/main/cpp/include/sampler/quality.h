@@ -0,0 +1,23 @@
+#ifndef KLARITY_SAMPLER_QUALITY_H
+#define KLARITY_SAMPLER_QUALITY_H
+
+enum class StretchQuality {
+    DEFAULT,
+    CHEAP,
+    HIGH,
+    LOW_LATENCY
+};
+
+enum class SpeedMode {
+    STRETCH,
+    RESAMPLE
+};
+
+enum class ResamplingInterpolator {
+    LINEAR,
+    CUBIC,
+    LAGRANGE,
+    KAISER_SINC
+};
+
+#endif //KLARITY_SAMPLER_QUALITY_H
@@ -0,0 +1,114 @@
+#ifndef KLARITY_SAMPLER_RESAMPLER_H
+#define KLARITY_SAMPLER_RESAMPLER_H
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+#include "exception.h"
+#include "quality.h"
+#include "dsp/delay.h"
+
+class Resampler {
+public:
+    virtual ~Resampler() = default;
+
+    virtual int getLatency() const = 0;
+
+    virtual int getMaxOutputSamples(int inputSamples, double step) const = 0;
+
+    virtual int process(
+            const float *const *inputs,
+            int inputSamples,
+            double step,
+            std::vector<std::vector<float>> &outputs
+    ) = 0;
+
+    virtual void reset() = 0;
+
+    static std::unique_ptr<Resampler> create(ResamplingInterpolator interpolator, int channels);
+};
+
+template<class Interpolator>
+class InterpolatingResampler : public Resampler {
+private:
+    Interpolator interpolator;
+
+    std::vector<std::vector<float>> buffers;
+
+    int bufferedSamples = 0;
+
+    double position = 0.0;
+
+public:
+    explicit InterpolatingResampler(int channels) : buffers(channels) {}
+
+    int getLatency() const override {
+        return std::max(0, static_cast<int>(std::ceil(static_cast<double>(Interpolator::latency))));
+    }
+
+    int getMaxOutputSamples(const int inputSamples, const double step) const override {
+        return static_cast<int>(std::ceil(static_cast<double>(bufferedSamples + inputSamples) / step)) + 1;
+    }
+
+    int process(
+            const float *const *inputs,
+            const int inputSamples,
+            const double step,
+            std::vector<std::vector<float>> &outputs
+    ) override {
+        const auto totalSamples = bufferedSamples + inputSamples;
+
+        for (size_t channel = 0; channel < buffers.size(); ++channel) {
+            auto &buffer = buffers[channel];
+
+            if (buffer.size() < static_cast<size_t>(totalSamples)) {
+                buffer.resize(std::max(static_cast<size_t>(totalSamples), buffer.size() * 2));
+            }
+
+            std::copy(inputs[channel], inputs[channel] + inputSamples, buffer.begin() + bufferedSamples);
+        }
+
+        const auto capacity = outputs.empty() ? 0 : static_cast<int>(outputs[0].size());
+
+        int outputSamples = 0;
+
+        while (outputSamples < capacity) {
+            const auto index = static_cast<int>(position);
+
+            if (index + Interpolator::inputLength > totalSamples) {
+                break;
+            }
+
+            const auto fraction = static_cast<float>(position - index);
+
+            for (size_t channel = 0; channel < buffers.size(); ++channel) {
+                outputs[channel][outputSamples] = interpolator.fractional(buffers[channel].data() + index, fraction);
+            }
+
+            ++outputSamples;
+
+            position += step;
+        }
+
+        const auto consumed = std::min(static_cast<int>(position), totalSamples);
+
+        for (auto &buffer: buffers) {
+            std::copy(buffer.begin() + consumed, buffer.begin() + totalSamples, buffer.begin());
+        }
+
+        bufferedSamples = totalSamples - consumed;
+
+        position -= consumed;
+
+        return outputSamples;
+    }
+
+    void reset() override {
+        bufferedSamples = 0;
+
+        position = 0.0;
+    }
+};
+
+#endif //KLARITY_SAMPLER_RESAMPLER_H
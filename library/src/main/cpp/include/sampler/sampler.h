@@ -1,11 +1,19 @@
 #ifndef KLARITY_SAMPLER_H
 #define KLARITY_SAMPLER_H
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <shared_mutex>
+#include <thread>
 #include "exception.h"
+#include "fifo.h"
+#include "interleave.h"
+#include "quality.h"
+#include "resampler.h"
 #include "stretch/stretch.h"
+#include "workers.h"
 #include <portaudio.h>
 
 struct Sampler {
@@ -16,20 +24,121 @@ private:
         }
     };
 
+    const uint32_t DEFAULT_BUFFER_MILLIS = 100;
+
+    const int MIN_WAIT_MICROS = 1000;
+
+    const uint32_t CROSSFADE_MILLIS = 10;
+
     std::shared_mutex mutex;
 
+    std::mutex writeMutex;
+
     uint32_t sampleRate;
 
     uint32_t channels;
 
     std::unique_ptr<PaStream, PaStreamDeleter> stream;
 
+    SpeedMode speedMode;
+
     std::unique_ptr<signalsmith::stretch::SignalsmithStretch<float>> stretch;
 
+    std::unique_ptr<Resampler> resampler;
+
+    std::unique_ptr<SampleFifo> fifo;
+
+    std::vector<std::vector<float>> inputBuffers;
+
+    std::vector<float *> inputPointers;
+
+    std::vector<const float *> inputPlanes;
+
+    std::vector<const float *> outputPlanes;
+
+    std::vector<std::vector<float>> outputBuffers;
+
+    std::vector<std::vector<float>> historyBuffers;
+
     std::vector<float> samples;
 
+    std::vector<float> pendingSamples;
+
+    size_t pendingSize = 0;
+
+    std::atomic<bool> isRunning{false};
+
+    std::atomic<bool> isBypassing{true};
+
+    std::atomic<bool> isPrimed{false};
+
+    std::atomic<bool> isDraining{false};
+
+    std::atomic<uint64_t> writtenFrames{0};
+
+    std::atomic<uint64_t> playedFrames{0};
+
+    std::atomic<uint64_t> underruns{0};
+
+    static int _callback(
+            const void *input,
+            void *output,
+            unsigned long frameCount,
+            const PaStreamCallbackTimeInfo *timeInfo,
+            PaStreamCallbackFlags statusFlags,
+            void *userData
+    );
+
+    int _render(float *output, unsigned long frameCount);
+
+    size_t _pushAvailable(const float *buffer, size_t size);
+
+    void _push(const float *buffer, size_t size);
+
+    void _pushPending();
+
+    void _awaitEmpty();
+
+    void _reserveScratch(std::vector<float> &buffer, size_t size);
+
+    void _reserveScratch(std::vector<std::vector<float>> &buffers, size_t size);
+
+    void _configureStretch(StretchQuality stretchQuality, int blockSamples, int intervalSamples);
+
+    void _configureStretchThreads(int stretchThreadCount);
+
+    void _process(int inputSamples, float volume, float playbackSpeedFactor);
+
+    int _stretch(int inputSamples, float playbackSpeedFactor);
+
+    int _resample(int inputSamples, float playbackSpeedFactor);
+
+    void _crossfade(int samples, int inputSamples, bool isFadingToInput);
+
+    void _updateHistory(int inputSamples);
+
+    void _resetHistory();
+
+    const float *const *_getOutputPlanes();
+
+    void _writeOutput(const float *const *planes, int outputSamples, float volume);
+
+    int _getLatency(bool isQueueIncluded);
+
 public:
-    explicit Sampler(uint32_t sampleRate, uint32_t channels);
+    explicit Sampler(
+            uint32_t sampleRate,
+            uint32_t channels,
+            uint32_t bufferFrames = 0,
+            StretchQuality stretchQuality = StretchQuality::DEFAULT,
+            int blockSamples = 0,
+            int intervalSamples = 0,
+            SpeedMode speedMode = SpeedMode::STRETCH,
+            ResamplingInterpolator resamplingInterpolator = ResamplingInterpolator::CUBIC,
+            int stretchThreadCount = 1
+    );
+
+    ~Sampler();
 
     Sampler(const Sampler &) = delete;
 
@@ -37,13 +146,23 @@ public:
 
     int start();
 
+    int getLatency(bool isQueueIncluded = true);
+
     void write(const uint8_t *buffer, int size, float volume, float playbackSpeedFactor);
 
+    void writePlanar(const uint8_t *buffer, int size, float volume, float playbackSpeedFactor);
+
     void stop();
 
     void flush();
 
     void drain(float volume, float playbackSpeedFactor);
+
+    uint64_t getWrittenFrames() const;
+
+    uint64_t getPlayedFrames() const;
+
+    uint64_t getUnderrunCount() const;
 };
 
 #endif //KLARITY_SAMPLER_H
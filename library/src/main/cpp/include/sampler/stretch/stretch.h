@@ -7,6 +7,7 @@
 SIGNALSMITH_DSP_VERSION_CHECK(1, 6, 0); // Check version is compatible
 #include <vector>
 #include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <random>
 
@@ -15,8 +16,8 @@ namespace signalsmith { namespace stretch {
         template<typename Sample=float>
         struct SignalsmithStretch {
 
-            SignalsmithStretch() : randomEngine(std::random_device{}()) {}
-            SignalsmithStretch(long seed) : randomEngine(seed) {}
+            SignalsmithStretch() : random(std::random_device{}()) {}
+            SignalsmithStretch(long seed) : random(seed) {}
 
             int blockSamples() const {
                 return stft.windowSize();
@@ -35,7 +36,7 @@ namespace signalsmith { namespace stretch {
                 stft.reset();
                 inputBuffer.reset();
                 prevInputOffset = -1;
-                channelBands.assign(channelBands.size(), Band());
+                clearBands();
                 silenceCounter = 2*stft.windowSize();
                 didSeek = false;
                 flushed = true;
@@ -55,19 +56,31 @@ namespace signalsmith { namespace stretch {
                 stft.resize(channels, blockSamples, intervalSamples);
                 bands = stft.bands();
                 inputBuffer.resize(channels, blockSamples + intervalSamples + 1);
-                timeBuffer.assign(stft.fftSize(), 0);
-                channelBands.assign(bands*channels, Band());
+                timeBuffers.assign(channels, std::vector<Sample>(stft.fftSize(), 0));
+                bandInput.resize(bands*channels);
+                bandPrevInput.resize(bands*channels);
+                bandOutput.resize(bands*channels);
+                bandPrevOutput.resize(bands*channels);
+                bandInputEnergy.assign(bands*channels, 0);
 
                 // Various phase rotations
                 rotCentreSpectrum.resize(bands);
-                rotPrevInterval.assign(bands, 0);
+                rotPrevInterval.resize(bands);
                 timeShiftPhases(blockSamples*Sample(-0.5), rotCentreSpectrum);
                 timeShiftPhases(-intervalSamples, rotPrevInterval);
                 peaks.reserve(bands);
                 energy.resize(bands);
                 smoothedEnergy.resize(bands);
                 outputMap.resize(bands);
-                channelPredictions.resize(channels*bands);
+                predictionEnergy.assign(channels*bands, 0);
+                predictionInput.resize(channels*bands);
+                shortVerticalTwist.resize(channels*bands);
+                longVerticalTwist.resize(channels*bands);
+                prevPredictionEnergy.assign(channels*bands, 0);
+                prevInputMapped.resize(channels*bands);
+                downInput.resize(channels*bands);
+                longDownInput.resize(channels*bands);
+                binTimeFactors.assign(channels*bands, 0);
             }
 
             /// Frequency multiplier, and optional tonality limit (as multiple of sample-rate)
@@ -89,6 +102,11 @@ namespace signalsmith { namespace stretch {
                 customFreqMap = inputToOutput;
             }
 
+            /// Spreads per-channel analysis, prediction and synthesis across `parallelFor(count, task)`, which must call `task(0)` ... `task(count - 1)` before returning.  Cross-channel steps stay serial, so the output is unchanged.
+            void setParallel(typename signalsmith::spectral::STFT<Sample>::ParallelFor parallelFor) {
+                stft.setParallel(parallelFor);
+            }
+
             // Provide previous input ("pre-roll"), without affecting the speed calculation.  You should ideally feed it one block-length + one interval
             template<class Inputs>
             void seek(Inputs &&inputs, int inputSamples, double playbackRate) {
@@ -120,10 +138,7 @@ namespace signalsmith { namespace stretch {
                     if (silenceCounter >= 2*stft.windowSize()) {
                         if (silenceFirst) {
                             silenceFirst = false;
-                            for (auto &b : channelBands) {
-                                b.input = b.prevInput = b.output = b.prevOutput = 0;
-                                b.inputEnergy = 0;
-                            }
+                            clearBands();
                         }
 
                         if (inputSamples > 0) {
@@ -171,7 +186,10 @@ namespace signalsmith { namespace stretch {
 
                         bool newSpectrum = didSeek || (inputInterval > 0);
                         if (newSpectrum) {
-                            for (int c = 0; c < channels; ++c) {
+                            bool analysePrevInput = didSeek || inputInterval != stft.interval(); // make sure the previous input is the correct distance in the past
+                            int prevIntervalOffset = inputOffset - stft.interval();
+                            stft.forEachChannel([&](int c) {
+                                auto &timeBuffer = timeBuffers[c];
                                 // Copy from the history buffer, if needed
                                 auto &&bufferChannel = inputBuffer[c];
                                 for (int i = 0; i < -inputOffset; ++i) {
@@ -183,53 +201,31 @@ namespace signalsmith { namespace stretch {
                                     timeBuffer[i] = inputChannel[i + inputOffset];
                                 }
                                 stft.analyse(c, timeBuffer);
-                            }
-                            flushed = false; // TODO: first block after a flush should be gain-compensated
-
-                            for (int c = 0; c < channels; ++c) {
-                                auto channelBands = bandsForChannel(c);
-                                auto &&spectrumBands = stft.spectrum[c];
-                                for (int b = 0; b < bands; ++b) {
-                                    channelBands[b].input = signalsmith::perf::mul(spectrumBands[b], rotCentreSpectrum[b]);
-                                }
-                            }
+                                importSpectrum(c, bandInput);
 
-                            if (didSeek || inputInterval != stft.interval()) { // make sure the previous input is the correct distance in the past
-                                int prevIntervalOffset = inputOffset - stft.interval();
-                                for (int c = 0; c < channels; ++c) {
+                                if (analysePrevInput) {
                                     // Copy from the history buffer, if needed
-                                    auto &&bufferChannel = inputBuffer[c];
                                     for (int i = 0; i < std::min(-prevIntervalOffset, stft.windowSize()); ++i) {
                                         timeBuffer[i] = bufferChannel[i + prevIntervalOffset];
                                     }
                                     // Copy the rest from the input
-                                    auto &&inputChannel = inputs[c];
                                     for (int i = std::max<int>(0, -prevIntervalOffset); i < stft.windowSize(); ++i) {
                                         timeBuffer[i] = inputChannel[i + prevIntervalOffset];
                                     }
                                     stft.analyse(c, timeBuffer);
+                                    importSpectrum(c, bandPrevInput);
                                 }
-                                for (int c = 0; c < channels; ++c) {
-                                    auto channelBands = bandsForChannel(c);
-                                    auto &&spectrumBands = stft.spectrum[c];
-                                    for (int b = 0; b < bands; ++b) {
-                                        channelBands[b].prevInput = signalsmith::perf::mul(spectrumBands[b], rotCentreSpectrum[b]);
-                                    }
-                                }
-                            }
+                            });
+                            flushed = false; // TODO: first block after a flush should be gain-compensated
                         }
 
                         Sample timeFactor = didSeek ? seekTimeFactor : stft.interval()/std::max<Sample>(1, inputInterval);
                         processSpectrum(newSpectrum, timeFactor);
                         didSeek = false;
 
-                        for (int c = 0; c < channels; ++c) {
-                            auto channelBands = bandsForChannel(c);
-                            auto &&spectrumBands = stft.spectrum[c];
-                            for (int b = 0; b < bands; ++b) {
-                                spectrumBands[b] = signalsmith::perf::mul<true>(channelBands[b].output, rotCentreSpectrum[b]);
-                            }
-                        }
+                        stft.forEachChannel([&](int c) {
+                            exportSpectrum(c, bandOutput);
+                        });
                     });
 
                     for (int c = 0; c < channels; ++c) {
@@ -275,12 +271,8 @@ namespace signalsmith { namespace stretch {
                 // Skip the output we just used/cleared
                 stft += plainOutput + foldedBackOutput;
                 // Reset the phase-vocoder stuff, so the next block gets a fresh start
-                for (int c = 0; c < channels; ++c) {
-                    auto channelBands = bandsForChannel(c);
-                    for (int b = 0; b < bands; ++b) {
-                        channelBands[b].prevInput = channelBands[b].prevOutput = 0;
-                    }
-                }
+                bandPrevInput.clear();
+                bandPrevOutput.clear();
                 flushed = true;
             }
         private:
@@ -297,67 +289,121 @@ namespace signalsmith { namespace stretch {
             signalsmith::delay::MultiBuffer<Sample> inputBuffer;
             int channels = 0, bands = 0;
             int prevInputOffset = -1;
-            std::vector<Sample> timeBuffer;
+            std::vector<std::vector<Sample>> timeBuffers;
             bool didSeek = false, flushed = true;
             Sample seekTimeFactor = 1;
 
-            std::vector<Complex> rotCentreSpectrum, rotPrevInterval;
+            // Complex values stored as separate real/imaginary arrays, so per-band loops vectorise
+            struct SplitSpectrum {
+                std::vector<Sample> real, imag;
+
+                void resize(int size) {
+                    real.assign(size, 0);
+                    imag.assign(size, 0);
+                }
+                void clear() {
+                    std::fill(real.begin(), real.end(), Sample(0));
+                    std::fill(imag.begin(), imag.end(), Sample(0));
+                }
+                Complex get(int index) const {
+                    return {real[index], imag[index]};
+                }
+                void set(int index, Complex value) {
+                    real[index] = value.real();
+                    imag[index] = value.imag();
+                }
+            };
+            static Sample norm(Sample real, Sample imag) {
+                return real*real + imag*imag;
+            }
+            // Split equivalent of `signalsmith::perf::mul()`, safe to run in-place
+            template<bool conjugateSecond=false>
+            static void mulSplit(const Sample *aReal, const Sample *aImag, const Sample *bReal, const Sample *bImag, Sample *outReal, Sample *outImag, int size) {
+                for (int i = 0; i < size; ++i) {
+                    Sample ar = aReal[i], ai = aImag[i], br = bReal[i], bi = bImag[i];
+                    if (conjugateSecond) {
+                        outReal[i] = br*ar + bi*ai;
+                        outImag[i] = br*ai - bi*ar;
+                    } else {
+                        outReal[i] = ar*br - ai*bi;
+                        outImag[i] = ar*bi + ai*br;
+                    }
+                }
+            }
+
+            SplitSpectrum rotCentreSpectrum, rotPrevInterval;
             Sample bandToFreq(Sample b) const {
                 return (b + Sample(0.5))/stft.fftSize();
             }
             Sample freqToBand(Sample f) const {
                 return f*stft.fftSize() - Sample(0.5);
             }
-            void timeShiftPhases(Sample shiftSamples, std::vector<Complex> &output) const {
+            void timeShiftPhases(Sample shiftSamples, SplitSpectrum &output) const {
                 for (int b = 0; b < bands; ++b) {
                     Sample phase = bandToFreq(b)*shiftSamples*Sample(-2*M_PI);
-                    output[b] = {std::cos(phase), std::sin(phase)};
+                    output.set(b, {std::cos(phase), std::sin(phase)});
+                }
+            }
+            // Reads a channel's STFT spectrum, rotated to the centre of the block
+            void importSpectrum(int channel, SplitSpectrum &split) {
+                const Complex *spectrum = stft.spectrum[channel];
+                Sample *real = split.real.data() + channel*bands, *imag = split.imag.data() + channel*bands;
+                const Sample *rotReal = rotCentreSpectrum.real.data(), *rotImag = rotCentreSpectrum.imag.data();
+                for (int b = 0; b < bands; ++b) {
+                    Sample sr = spectrum[b].real(), si = spectrum[b].imag();
+                    real[b] = sr*rotReal[b] - si*rotImag[b];
+                    imag[b] = sr*rotImag[b] + si*rotReal[b];
+                }
+            }
+            void exportSpectrum(int channel, const SplitSpectrum &split) {
+                Complex *spectrum = stft.spectrum[channel];
+                const Sample *real = split.real.data() + channel*bands, *imag = split.imag.data() + channel*bands;
+                const Sample *rotReal = rotCentreSpectrum.real.data(), *rotImag = rotCentreSpectrum.imag.data();
+                for (int b = 0; b < bands; ++b) {
+                    spectrum[b] = {rotReal[b]*real[b] + rotImag[b]*imag[b], rotReal[b]*imag[b] - rotImag[b]*real[b]};
                 }
             }
 
-            struct Band {
-                Complex input, prevInput{0};
-                Complex output, prevOutput{0};
-                Sample inputEnergy;
-            };
-            std::vector<Band> channelBands;
-            Band * bandsForChannel(int channel) {
-                return channelBands.data() + channel*bands;
+            // Per-band state for all channels, indexed by `channel*bands + band`
+            SplitSpectrum bandInput, bandPrevInput, bandOutput, bandPrevOutput;
+            std::vector<Sample> bandInputEnergy;
+            void clearBands() {
+                bandInput.clear();
+                bandPrevInput.clear();
+                bandOutput.clear();
+                bandPrevOutput.clear();
+                std::fill(bandInputEnergy.begin(), bandInputEnergy.end(), Sample(0));
+            }
+            void updateInputEnergy() {
+                const Sample *real = bandInput.real.data(), *imag = bandInput.imag.data();
+                Sample *energies = bandInputEnergy.data();
+                for (int i = 0; i < channels*bands; ++i) {
+                    energies[i] = norm(real[i], imag[i]);
+                }
             }
-            template<Complex Band::*member>
-            Complex getBand(int channel, int index) {
+            Complex getBand(const SplitSpectrum &split, int channel, int index) const {
                 if (index < 0 || index >= bands) return 0;
-                return channelBands[index + channel*bands].*member;
+                return split.get(index + channel*bands);
             }
-            template<Complex Band::*member>
-            Complex getFractional(int channel, int lowIndex, Sample fractional) {
-                Complex low = getBand<member>(channel, lowIndex);
-                Complex high = getBand<member>(channel, lowIndex + 1);
+            Complex getFractional(const SplitSpectrum &split, int channel, int lowIndex, Sample fractional) const {
+                Complex low = getBand(split, channel, lowIndex);
+                Complex high = getBand(split, channel, lowIndex + 1);
                 return low + (high - low)*fractional;
             }
-            template<Complex Band::*member>
-            Complex getFractional(int channel, Sample inputIndex) {
+            Complex getFractional(const SplitSpectrum &split, int channel, Sample inputIndex) const {
                 int lowIndex = std::floor(inputIndex);
                 Sample fracIndex = inputIndex - lowIndex;
-                return getFractional<member>(channel, lowIndex, fracIndex);
+                return getFractional(split, channel, lowIndex, fracIndex);
             }
-            template<Sample Band::*member>
-            Sample getBand(int channel, int index) {
+            Sample getBand(const std::vector<Sample> &values, int channel, int index) const {
                 if (index < 0 || index >= bands) return 0;
-                return channelBands[index + channel*bands].*member;
+                return values[index + channel*bands];
             }
-            template<Sample Band::*member>
-            Sample getFractional(int channel, int lowIndex, Sample fractional) {
-                Sample low = getBand<member>(channel, lowIndex);
-                Sample high = getBand<member>(channel, lowIndex + 1);
+            Sample getFractional(const std::vector<Sample> &values, int channel, int lowIndex, Sample fractional) const {
+                Sample low = getBand(values, channel, lowIndex);
+                Sample high = getBand(values, channel, lowIndex + 1);
                 return low + (high - low)*fractional;
             }
-            template<Sample Band::*member>
-            Sample getFractional(int channel, Sample inputIndex) {
-                int lowIndex = std::floor(inputIndex);
-                Sample fracIndex = inputIndex - lowIndex;
-                return getFractional<member>(channel, lowIndex, fracIndex);
-            }
 
             struct Peak {
                 Sample input, output;
@@ -369,162 +415,201 @@ namespace signalsmith { namespace stretch {
             };
             std::vector<PitchMapPoint> outputMap;
 
-            struct Prediction {
-                Sample energy = 0;
-                Complex input;
-                Complex shortVerticalTwist, longVerticalTwist;
+            // Per-channel predictions, indexed by `channel*bands + band`
+            std::vector<Sample> predictionEnergy;
+            SplitSpectrum predictionInput, shortVerticalTwist, longVerticalTwist;
+            // Per-channel scratch for the prediction passes, so channels can run concurrently
+            std::vector<Sample> prevPredictionEnergy, binTimeFactors;
+            SplitSpectrum prevInputMapped, downInput, longDownInput;
+
+            static Complex makeOutput(Sample bandEnergy, Complex input, Complex phase) {
+                Sample phaseNorm = norm(phase.real(), phase.imag());
+                if (phaseNorm <= noiseFloor) {
+                    phase = input; // prediction is too weak, fall back to the input
+                    phaseNorm = norm(input.real(), input.imag()) + noiseFloor;
+                }
+                return phase*std::sqrt(bandEnergy/phaseNorm);
+            }
+
+            /// Counter-based generator: each value is a hash of (key, counter), so a whole block can be filled in one vectorisable pass
+            struct RandomGenerator {
+                uint32_t key;
+                uint64_t counter = 0;
+
+                static uint32_t hash(uint32_t x) {
+                    x ^= x >> 16;
+                    x *= 0x7feb352dU;
+                    x ^= x >> 15;
+                    x *= 0x846ca68bU;
+                    x ^= x >> 16;
+                    return x;
+                }
 
-                Complex makeOutput(Complex phase) {
-                    Sample phaseNorm = std::norm(phase);
-                    if (phaseNorm <= noiseFloor) {
-                        phase = input; // prediction is too weak, fall back to the input
-                        phaseNorm = std::norm(input) + noiseFloor;
+                RandomGenerator(long seed) {
+                    uint64_t bits = uint64_t(seed);
+                    key = hash(uint32_t(bits) ^ hash(uint32_t(bits >> 32) + 0x9e3779b9U));
+                }
+
+                /// Fills `output` with values uniformly distributed in [low, high)
+                void fillUniform(Sample *output, int size, Sample low, Sample high) {
+                    Sample scale = (high - low)/Sample(16777216);
+                    uint32_t blockKey = key ^ hash(uint32_t(counter >> 32));
+                    uint32_t blockCounter = uint32_t(counter);
+                    for (int i = 0; i < size; ++i) {
+                        uint32_t x = hash((blockCounter + uint32_t(i))*0x9e3779b9U ^ blockKey);
+                        output[i] = low + Sample(int32_t(x >> 8))*scale;
                     }
-                    return phase*std::sqrt(energy/phaseNorm);
+                    counter += uint64_t(size);
                 }
             };
-            std::vector<Prediction> channelPredictions;
-            Prediction * predictionsForChannel(int c) {
-                return channelPredictions.data() + c*bands;
-            }
-
-            std::default_random_engine randomEngine;
+            RandomGenerator random;
 
             void processSpectrum(bool newSpectrum, Sample timeFactor) {
                 timeFactor = std::max<Sample>(timeFactor, 1/maxCleanStretch);
                 bool randomTimeFactor = (timeFactor > maxCleanStretch);
-                std::uniform_real_distribution<Sample> timeFactorDist(maxCleanStretch*2*randomTimeFactor - timeFactor, timeFactor);
 
                 if (newSpectrum) {
                     for (int c = 0; c < channels; ++c) {
-                        auto bins = bandsForChannel(c);
-                        for (int b = 0; b < bands; ++b) {
-                            auto &bin = bins[b];
-                            bin.prevOutput = signalsmith::perf::mul(bin.prevOutput, rotPrevInterval[b]);
-                            bin.prevInput = signalsmith::perf::mul(bin.prevInput, rotPrevInterval[b]);
-                        }
+                        int offset = c*bands;
+                        mulSplit(bandPrevOutput.real.data() + offset, bandPrevOutput.imag.data() + offset, rotPrevInterval.real.data(), rotPrevInterval.imag.data(), bandPrevOutput.real.data() + offset, bandPrevOutput.imag.data() + offset, bands);
+                        mulSplit(bandPrevInput.real.data() + offset, bandPrevInput.imag.data() + offset, rotPrevInterval.real.data(), rotPrevInterval.imag.data(), bandPrevInput.real.data() + offset, bandPrevInput.imag.data() + offset, bands);
                     }
                 }
 
                 Sample smoothingBins = Sample(stft.fftSize())/stft.interval();
                 int longVerticalStep = std::round(smoothingBins);
-                if (customFreqMap || freqMultiplier != 1) {
+                int longVerticalStart = std::min(std::max(1, longVerticalStep), bands);
+                bool identityMap = !(customFreqMap || freqMultiplier != 1);
+                if (!identityMap) {
                     findPeaks(smoothingBins);
                     updateOutputMap();
                 } else { // we're not pitch-shifting, so no need to find peaks etc.
-                    for (int c = 0; c < channels; ++c) {
-                        Band *bins = bandsForChannel(c);
-                        for (int b = 0; b < bands; ++b) {
-                            bins[b].inputEnergy = std::norm(bins[b].input);
-                        }
-                    }
+                    updateInputEnergy();
                     for (int b = 0; b < bands; ++b) {
                         outputMap[b] = {Sample(b), 1};
                     }
                 }
 
+                // Random factors are drawn up-front for all channels, so results don't depend on scheduling
+                if (randomTimeFactor) {
+                    random.fillUniform(binTimeFactors.data(), channels*bands, maxCleanStretch*2 - timeFactor, timeFactor);
+                }
+
                 // Preliminary output prediction from phase-vocoder
-                for (int c = 0; c < channels; ++c) {
-                    Band *bins = bandsForChannel(c);
-                    auto *predictions = predictionsForChannel(c);
-                    for (int b = 0; b < bands; ++b) {
-                        auto mapPoint = outputMap[b];
-                        int lowIndex = std::floor(mapPoint.inputBin);
-                        Sample fracIndex = mapPoint.inputBin - lowIndex;
-
-                        Prediction &prediction = predictions[b];
-                        Sample prevEnergy = prediction.energy;
-                        prediction.energy = getFractional<&Band::inputEnergy>(c, lowIndex, fracIndex);
-                        prediction.energy *= std::max<Sample>(0, mapPoint.freqGrad); // scale the energy according to local stretch factor
-                        prediction.input = getFractional<&Band::input>(c, lowIndex, fracIndex);
-
-                        auto &outputBin = bins[b];
-                        Complex prevInput = getFractional<&Band::prevInput>(c, lowIndex, fracIndex);
-                        Complex freqTwist = signalsmith::perf::mul<true>(prediction.input, prevInput);
-                        Complex phase = signalsmith::perf::mul(outputBin.prevOutput, freqTwist);
-                        outputBin.output = phase/(std::max(prevEnergy, prediction.energy) + noiseFloor);
-
-                        if (b > 0) {
-                            Sample binTimeFactor = randomTimeFactor ? timeFactorDist(randomEngine) : timeFactor;
-                            Complex downInput = getFractional<&Band::input>(c, mapPoint.inputBin - binTimeFactor);
-                            prediction.shortVerticalTwist = signalsmith::perf::mul<true>(prediction.input, downInput);
-                            if (b >= longVerticalStep) {
-                                Complex longDownInput = getFractional<&Band::input>(c, mapPoint.inputBin - longVerticalStep*binTimeFactor);
-                                prediction.longVerticalTwist = signalsmith::perf::mul<true>(prediction.input, longDownInput);
-                            } else {
-                                prediction.longVerticalTwist = 0;
-                            }
-                        } else {
-                            prediction.shortVerticalTwist = prediction.longVerticalTwist = 0;
+                stft.forEachChannel([&](int c) {
+                    int offset = c*bands;
+                    Sample *energies = predictionEnergy.data() + offset;
+                    Sample *inputReal = predictionInput.real.data() + offset, *inputImag = predictionInput.imag.data() + offset;
+                    std::copy(energies, energies + bands, prevPredictionEnergy.begin() + offset);
+
+                    if (identityMap) { // the map lands exactly on input bands, so no interpolation needed
+                        std::copy(bandInputEnergy.begin() + offset, bandInputEnergy.begin() + offset + bands, energies);
+                        std::copy(bandInput.real.begin() + offset, bandInput.real.begin() + offset + bands, inputReal);
+                        std::copy(bandInput.imag.begin() + offset, bandInput.imag.begin() + offset + bands, inputImag);
+                        std::copy(bandPrevInput.real.begin() + offset, bandPrevInput.real.begin() + offset + bands, prevInputMapped.real.begin() + offset);
+                        std::copy(bandPrevInput.imag.begin() + offset, bandPrevInput.imag.begin() + offset + bands, prevInputMapped.imag.begin() + offset);
+                    } else {
+                        for (int b = 0; b < bands; ++b) {
+                            auto mapPoint = outputMap[b];
+                            int lowIndex = std::floor(mapPoint.inputBin);
+                            Sample fracIndex = mapPoint.inputBin - lowIndex;
+
+                            energies[b] = getFractional(bandInputEnergy, c, lowIndex, fracIndex);
+                            energies[b] *= std::max<Sample>(0, mapPoint.freqGrad); // scale the energy according to local stretch factor
+                            predictionInput.set(offset + b, getFractional(bandInput, c, lowIndex, fracIndex));
+                            prevInputMapped.set(offset + b, getFractional(bandPrevInput, c, lowIndex, fracIndex));
                         }
                     }
-                }
+
+                    // Vertical neighbours are read at fractional bands, so these gathers stay scalar
+                    for (int b = 1; b < bands; ++b) {
+                        Sample inputBin = outputMap[b].inputBin;
+                        Sample binTimeFactor = randomTimeFactor ? binTimeFactors[offset + b] : timeFactor;
+                        downInput.set(offset + b, getFractional(bandInput, c, inputBin - binTimeFactor));
+                        if (b >= longVerticalStart) {
+                            longDownInput.set(offset + b, getFractional(bandInput, c, inputBin - longVerticalStep*binTimeFactor));
+                        }
+                    }
+
+                    const Sample *prevReal = prevInputMapped.real.data() + offset, *prevImag = prevInputMapped.imag.data() + offset;
+                    const Sample *prevOutputReal = bandPrevOutput.real.data() + offset, *prevOutputImag = bandPrevOutput.imag.data() + offset;
+                    const Sample *prevEnergies = prevPredictionEnergy.data() + offset;
+                    Sample *outputReal = bandOutput.real.data() + offset, *outputImag = bandOutput.imag.data() + offset;
+                    for (int b = 0; b < bands; ++b) {
+                        Sample twistReal = prevReal[b]*inputReal[b] + prevImag[b]*inputImag[b];
+                        Sample twistImag = prevReal[b]*inputImag[b] - prevImag[b]*inputReal[b];
+                        Sample phaseReal = prevOutputReal[b]*twistReal - prevOutputImag[b]*twistImag;
+                        Sample phaseImag = prevOutputReal[b]*twistImag + prevOutputImag[b]*twistReal;
+                        Sample divisor = std::max(prevEnergies[b], energies[b]) + noiseFloor;
+                        outputReal[b] = phaseReal/divisor;
+                        outputImag[b] = phaseImag/divisor;
+                    }
+
+                    Sample *shortReal = shortVerticalTwist.real.data() + offset, *shortImag = shortVerticalTwist.imag.data() + offset;
+                    Sample *longReal = longVerticalTwist.real.data() + offset, *longImag = longVerticalTwist.imag.data() + offset;
+                    shortReal[0] = shortImag[0] = 0;
+                    std::fill(longReal, longReal + longVerticalStart, Sample(0));
+                    std::fill(longImag, longImag + longVerticalStart, Sample(0));
+                    mulSplit<true>(inputReal + 1, inputImag + 1, downInput.real.data() + offset + 1, downInput.imag.data() + offset + 1, shortReal + 1, shortImag + 1, bands - 1);
+                    mulSplit<true>(inputReal + longVerticalStart, inputImag + longVerticalStart, longDownInput.real.data() + offset + longVerticalStart, longDownInput.imag.data() + offset + longVerticalStart, longReal + longVerticalStart, longImag + longVerticalStart, bands - longVerticalStart);
+                });
 
                 // Re-predict using phase differences between frequencies
                 for (int b = 0; b < bands; ++b) {
                     // Find maximum-energy channel and calculate that
                     int maxChannel = 0;
-                    Sample maxEnergy = predictionsForChannel(0)[b].energy;
+                    Sample maxEnergy = predictionEnergy[b];
                     for (int c = 1; c < channels; ++c) {
-                        Sample e = predictionsForChannel(c)[b].energy;
+                        Sample e = predictionEnergy[c*bands + b];
                         if (e > maxEnergy) {
                             maxChannel = c;
                             maxEnergy = e;
                         }
                     }
 
-                    auto *predictions = predictionsForChannel(maxChannel);
-                    auto &prediction = predictions[b];
-                    auto *bins = bandsForChannel(maxChannel);
-                    auto &outputBin = bins[b];
+                    int index = maxChannel*bands + b;
+                    Complex input = predictionInput.get(index);
 
                     Complex phase = 0;
 
                     // Upwards vertical steps
                     if (b > 0) {
-                        auto &downBin = bins[b - 1];
-                        phase += signalsmith::perf::mul(downBin.output, prediction.shortVerticalTwist);
+                        phase += signalsmith::perf::mul(bandOutput.get(index - 1), shortVerticalTwist.get(index));
 
                         if (b >= longVerticalStep) {
-                            auto &longDownBin = bins[b - longVerticalStep];
-                            phase += signalsmith::perf::mul(longDownBin.output, prediction.longVerticalTwist);
+                            phase += signalsmith::perf::mul(bandOutput.get(index - longVerticalStep), longVerticalTwist.get(index));
                         }
                     }
                     // Downwards vertical steps
                     if (b < bands - 1) {
-                        auto &upPrediction = predictions[b + 1];
-                        auto &upBin = bins[b + 1];
-                        phase += signalsmith::perf::mul<true>(upBin.output, upPrediction.shortVerticalTwist);
+                        phase += signalsmith::perf::mul<true>(bandOutput.get(index + 1), shortVerticalTwist.get(index + 1));
 
                         if (b < bands - longVerticalStep) {
-                            auto &longUpPrediction = predictions[b + longVerticalStep];
-                            auto &longUpBin = bins[b + longVerticalStep];
-                            phase += signalsmith::perf::mul<true>(longUpBin.output, longUpPrediction.longVerticalTwist);
+                            phase += signalsmith::perf::mul<true>(bandOutput.get(index + longVerticalStep), longVerticalTwist.get(index + longVerticalStep));
                         }
                     }
 
-                    outputBin.output = prediction.makeOutput(phase);
+                    Complex output = makeOutput(predictionEnergy[index], input, phase);
+                    bandOutput.set(index, output);
 
                     // All other bins are locked in phase
                     for (int c = 0; c < channels; ++c) {
                         if (c != maxChannel) {
-                            auto &channelBin = bandsForChannel(c)[b];
-                            auto &channelPrediction = predictionsForChannel(c)[b];
+                            int channelIndex = c*bands + b;
+                            Complex channelInput = predictionInput.get(channelIndex);
 
-                            Complex channelTwist = signalsmith::perf::mul<true>(channelPrediction.input, prediction.input);
-                            Complex channelPhase = signalsmith::perf::mul(outputBin.output, channelTwist);
-                            channelBin.output = channelPrediction.makeOutput(channelPhase);
+                            Complex channelTwist = signalsmith::perf::mul<true>(channelInput, input);
+                            Complex channelPhase = signalsmith::perf::mul(output, channelTwist);
+                            bandOutput.set(channelIndex, makeOutput(predictionEnergy[channelIndex], channelInput, channelPhase));
                         }
                     }
                 }
 
                 if (newSpectrum) {
-                    for (auto &bin : channelBands) {
-                        bin.prevOutput = bin.output;
-                        bin.prevInput = bin.input;
-                    }
+                    bandPrevOutput = bandOutput;
+                    bandPrevInput = bandInput;
                 } else {
-                    for (auto &bin : channelBands) bin.prevOutput = bin.output;
+                    bandPrevOutput = bandOutput;
                 }
             }
 
@@ -532,12 +617,11 @@ namespace signalsmith { namespace stretch {
             void smoothEnergy(Sample smoothingBins) {
                 Sample smoothingSlew = 1/(1 + smoothingBins*Sample(0.5));
                 for (auto &e : energy) e = 0;
+                updateInputEnergy(); // Used for interpolating prediction energy
                 for (int c = 0; c < channels; ++c) {
-                    Band *bins = bandsForChannel(c);
+                    const Sample *channelEnergy = bandInputEnergy.data() + c*bands;
                     for (int b = 0; b < bands; ++b) {
-                        Sample e = std::norm(bins[b].input);
-                        bins[b].inputEnergy = e; // Used for interpolating prediction energy
-                        energy[b] += e;
+                        energy[b] += channelEnergy[b];
                     }
                 }
                 for (int b = 0; b < bands; ++b) {
@@ -10,6 +10,8 @@ jclass poolExceptionClass = nullptr;
 
 jclass samplerExceptionClass = nullptr;
 
+jclass pipelineExceptionClass = nullptr;
+
 jclass formatClass = nullptr;
 
 jmethodID formatConstructor = nullptr;
@@ -18,6 +20,10 @@ jclass audioFrameClass = nullptr;
 
 jmethodID audioFrameConstructor = nullptr;
 
+jclass audioChunkClass = nullptr;
+
+jmethodID audioChunkConstructor = nullptr;
+
 jclass videoFrameClass = nullptr;
 
 jmethodID videoFrameConstructor = nullptr;
@@ -42,6 +48,16 @@ Sampler *getSamplerPointer(jlong handle) {
     return sampler;
 }
 
+AudioPipeline *getAudioPipelinePointer(jlong handle) {
+    auto pipeline = reinterpret_cast<AudioPipeline *>(handle);
+
+    if (!pipeline) {
+        throw std::runtime_error("Invalid pipeline handle");
+    }
+
+    return pipeline;
+}
+
 JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *vm, void *reserved) {
     JNIEnv *env;
 
@@ -89,6 +105,14 @@ JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *vm, void *reserved) {
         return JNI_ERR;
     }
 
+    pipelineExceptionClass = reinterpret_cast<jclass>(
+            env->NewGlobalRef(env->FindClass("io/github/numq/klarity/pipeline/PipelineException"))
+    );
+
+    if (pipelineExceptionClass == nullptr) {
+        return JNI_ERR;
+    }
+
     formatClass = reinterpret_cast<jclass>(
             env->NewGlobalRef(env->FindClass("io/github/numq/klarity/format/NativeFormat"))
     );
@@ -97,7 +121,7 @@ JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *vm, void *reserved) {
         return JNI_ERR;
     }
 
-    formatConstructor = env->GetMethodID(formatClass, "<init>", "(Ljava/lang/String;JIIIIDII)V");
+    formatConstructor = env->GetMethodID(formatClass, "<init>", "(Ljava/lang/String;JIIIIIIDIII[I)V");
 
     if (formatConstructor == nullptr) {
         return JNI_ERR;
@@ -117,6 +141,20 @@ JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *vm, void *reserved) {
         return JNI_ERR;
     }
 
+    audioChunkClass = reinterpret_cast<jclass>(
+            env->NewGlobalRef(env->FindClass("io/github/numq/klarity/frame/NativeAudioChunk"))
+    );
+
+    if (audioChunkClass == nullptr) {
+        return JNI_ERR;
+    }
+
+    audioChunkConstructor = env->GetMethodID(audioChunkClass, "<init>", "(IJ)V");
+
+    if (audioChunkConstructor == nullptr) {
+        return JNI_ERR;
+    }
+
     videoFrameClass = reinterpret_cast<jclass>(
             env->NewGlobalRef(env->FindClass("io/github/numq/klarity/frame/NativeVideoFrame"))
     );
@@ -125,7 +163,7 @@ JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *vm, void *reserved) {
         return JNI_ERR;
     }
 
-    videoFrameConstructor = env->GetMethodID(videoFrameClass, "<init>", "(IJ)V");
+    videoFrameConstructor = env->GetMethodID(videoFrameClass, "<init>", "(IJII)V");
 
     if (videoFrameConstructor == nullptr) {
         return JNI_ERR;
@@ -179,6 +217,12 @@ JNIEXPORT void JNICALL JNI_OnUnload(JavaVM *vm, void *reserved) {
         samplerExceptionClass = nullptr;
     }
 
+    if (pipelineExceptionClass) {
+        env->DeleteGlobalRef(pipelineExceptionClass);
+
+        pipelineExceptionClass = nullptr;
+    }
+
     if (formatClass) {
         env->DeleteGlobalRef(formatClass);
 
@@ -191,6 +235,12 @@ JNIEXPORT void JNICALL JNI_OnUnload(JavaVM *vm, void *reserved) {
         audioFrameClass = nullptr;
     }
 
+    if (audioChunkClass) {
+        env->DeleteGlobalRef(audioChunkClass);
+
+        audioChunkClass = nullptr;
+    }
+
     if (videoFrameClass) {
         env->DeleteGlobalRef(videoFrameClass);
 
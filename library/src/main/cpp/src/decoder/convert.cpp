@@ -0,0 +1,681 @@
+#include "convert.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define KLARITY_CONVERT_X86
+#include <immintrin.h>
+#elif (defined(__aarch64__) || defined(_M_ARM64)) && defined(KLARITY_BENCHMARK)
+#define KLARITY_CONVERT_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define KLARITY_TARGET(name) __attribute__((target(name)))
+#else
+#define KLARITY_TARGET(name)
+#endif
+
+namespace {
+    constexpr int Y_OFFSET = 16;
+
+    constexpr int UV_OFFSET = 128;
+
+    constexpr int Y_COEFFICIENT = 19077;
+
+    constexpr int V_TO_R_COEFFICIENT = 26149;
+
+    constexpr int U_TO_G_COEFFICIENT = 6419;
+
+    constexpr int V_TO_G_COEFFICIENT = 13320;
+
+    constexpr int U_TO_B_COEFFICIENT = 33050;
+
+    constexpr int PRECISION = 14;
+
+    constexpr int ROUNDING = 1 << (PRECISION - 1);
+
+    inline uint32_t yuvToBgra(const int y, const int u, const int v) {
+        const int luma = (y - Y_OFFSET) * Y_COEFFICIENT + ROUNDING;
+
+        const int d = u - UV_OFFSET;
+
+        const int e = v - UV_OFFSET;
+
+        const int r = std::clamp((luma + V_TO_R_COEFFICIENT * e) >> PRECISION, 0, 255);
+
+        const int g = std::clamp((luma - U_TO_G_COEFFICIENT * d - V_TO_G_COEFFICIENT * e) >> PRECISION, 0, 255);
+
+        const int b = std::clamp((luma + U_TO_B_COEFFICIENT * d) >> PRECISION, 0, 255);
+
+        return static_cast<uint32_t>(b) |
+               static_cast<uint32_t>(g) << 8 |
+               static_cast<uint32_t>(r) << 16 |
+               0xFF000000u;
+    }
+
+    void rowScalar(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *dst, const int width, int x) {
+        for (; x < width; ++x) {
+            const uint32_t pixel = yuvToBgra(y[x], u[x], v[x]);
+
+            std::memcpy(dst + x * 4, &pixel, sizeof(pixel));
+        }
+    }
+
+    void rowFallback(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *dst, const int width) {
+        rowScalar(y, u, v, dst, width, 0);
+    }
+
+    void blendPlaneScalar(const uint8_t *near, const uint8_t *far, uint16_t *sums, const int chromaWidth, int i) {
+        for (; i < chromaWidth; ++i) {
+            sums[i + 1] = static_cast<uint16_t>(3 * near[i] + far[i]);
+        }
+    }
+
+    void blendNV12Scalar(
+            const uint8_t *near,
+            const uint8_t *far,
+            uint16_t *uSums,
+            uint16_t *vSums,
+            const int chromaWidth,
+            int i
+    ) {
+        for (; i < chromaWidth; ++i) {
+            uSums[i + 1] = static_cast<uint16_t>(3 * near[i * 2] + far[i * 2]);
+
+            vSums[i + 1] = static_cast<uint16_t>(3 * near[i * 2 + 1] + far[i * 2 + 1]);
+        }
+    }
+
+    inline void padSums(uint16_t *sums, const int chromaWidth) {
+        sums[0] = sums[1];
+
+        sums[chromaWidth + 1] = sums[chromaWidth];
+    }
+
+    void interpolateScalar(const uint16_t *sums, uint8_t *dst, const int chromaWidth, int i) {
+        for (; i < chromaWidth; ++i) {
+            const int center = 3 * sums[i + 1] + 8;
+
+            dst[i * 2] = static_cast<uint8_t>((center + sums[i]) >> 4);
+
+            dst[i * 2 + 1] = static_cast<uint8_t>((center + sums[i + 2]) >> 4);
+        }
+    }
+
+    void planeChromaFallback(
+            const uint8_t *near,
+            const uint8_t *far,
+            const int chromaWidth,
+            uint16_t *sums,
+            uint8_t *dst
+    ) {
+        blendPlaneScalar(near, far, sums, chromaWidth, 0);
+
+        padSums(sums, chromaWidth);
+
+        interpolateScalar(sums, dst, chromaWidth, 0);
+    }
+
+    void nv12ChromaFallback(
+            const uint8_t *near,
+            const uint8_t *far,
+            const int chromaWidth,
+            uint16_t *uSums,
+            uint16_t *vSums,
+            uint8_t *u,
+            uint8_t *v
+    ) {
+        blendNV12Scalar(near, far, uSums, vSums, chromaWidth, 0);
+
+        padSums(uSums, chromaWidth);
+
+        padSums(vSums, chromaWidth);
+
+        interpolateScalar(uSums, u, chromaWidth, 0);
+
+        interpolateScalar(vSums, v, chromaWidth, 0);
+    }
+
+#if defined(KLARITY_CONVERT_X86)
+
+    inline uint32_t load32(const uint8_t *src) {
+        uint32_t value;
+
+        std::memcpy(&value, src, sizeof(value));
+
+        return value;
+    }
+
+    KLARITY_TARGET("sse4.1")
+    inline __m128i packBgraSse4(__m128i y, __m128i u, __m128i v) {
+        const auto luma = _mm_add_epi32(
+                _mm_mullo_epi32(_mm_sub_epi32(y, _mm_set1_epi32(Y_OFFSET)), _mm_set1_epi32(Y_COEFFICIENT)),
+                _mm_set1_epi32(ROUNDING)
+        );
+
+        const auto d = _mm_sub_epi32(u, _mm_set1_epi32(UV_OFFSET));
+
+        const auto e = _mm_sub_epi32(v, _mm_set1_epi32(UV_OFFSET));
+
+        const auto zero = _mm_setzero_si128();
+
+        const auto max = _mm_set1_epi32(255);
+
+        auto r = _mm_srai_epi32(_mm_add_epi32(luma, _mm_mullo_epi32(e, _mm_set1_epi32(V_TO_R_COEFFICIENT))), PRECISION);
+
+        auto g = _mm_srai_epi32(_mm_sub_epi32(_mm_sub_epi32(
+                luma,
+                _mm_mullo_epi32(d, _mm_set1_epi32(U_TO_G_COEFFICIENT))
+        ), _mm_mullo_epi32(e, _mm_set1_epi32(V_TO_G_COEFFICIENT))), PRECISION);
+
+        auto b = _mm_srai_epi32(_mm_add_epi32(luma, _mm_mullo_epi32(d, _mm_set1_epi32(U_TO_B_COEFFICIENT))), PRECISION);
+
+        r = _mm_min_epi32(_mm_max_epi32(r, zero), max);
+
+        g = _mm_min_epi32(_mm_max_epi32(g, zero), max);
+
+        b = _mm_min_epi32(_mm_max_epi32(b, zero), max);
+
+        return _mm_or_si128(
+                _mm_or_si128(b, _mm_slli_epi32(g, 8)),
+                _mm_or_si128(_mm_slli_epi32(r, 16), _mm_set1_epi32(static_cast<int>(0xFF000000u)))
+        );
+    }
+
+    KLARITY_TARGET("sse4.1")
+    void rowSse4(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *dst, const int width) {
+        int x = 0;
+
+        for (; x + 4 <= width; x += 4) {
+            const auto yValues = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(static_cast<int>(load32(y + x))));
+
+            const auto uValues = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(static_cast<int>(load32(u + x))));
+
+            const auto vValues = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(static_cast<int>(load32(v + x))));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x * 4), packBgraSse4(yValues, uValues, vValues));
+        }
+
+        rowScalar(y, u, v, dst, width, x);
+    }
+
+    KLARITY_TARGET("sse4.1")
+    void interpolateSse4(const uint16_t *sums, uint8_t *dst, const int chromaWidth) {
+        const auto bias = _mm_set1_epi16(8);
+
+        int i = 0;
+
+        for (; i + 8 <= chromaWidth; i += 8) {
+            const auto left = _mm_loadu_si128(reinterpret_cast<const __m128i *>(sums + i));
+
+            const auto center = _mm_loadu_si128(reinterpret_cast<const __m128i *>(sums + i + 1));
+
+            const auto right = _mm_loadu_si128(reinterpret_cast<const __m128i *>(sums + i + 2));
+
+            const auto weighted = _mm_add_epi16(_mm_add_epi16(center, _mm_slli_epi16(center, 1)), bias);
+
+            const auto even = _mm_srli_epi16(_mm_add_epi16(weighted, left), 4);
+
+            const auto odd = _mm_srli_epi16(_mm_add_epi16(weighted, right), 4);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 2), _mm_or_si128(even, _mm_slli_epi16(odd, 8)));
+        }
+
+        interpolateScalar(sums, dst, chromaWidth, i);
+    }
+
+    KLARITY_TARGET("sse4.1")
+    void planeChromaSse4(const uint8_t *near, const uint8_t *far, const int chromaWidth, uint16_t *sums, uint8_t *dst) {
+        const auto three = _mm_set1_epi16(3);
+
+        int i = 0;
+
+        for (; i + 8 <= chromaWidth; i += 8) {
+            const auto nearValues = _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(near + i)));
+
+            const auto farValues = _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(far + i)));
+
+            _mm_storeu_si128(
+                    reinterpret_cast<__m128i *>(sums + i + 1),
+                    _mm_add_epi16(_mm_mullo_epi16(nearValues, three), farValues)
+            );
+        }
+
+        blendPlaneScalar(near, far, sums, chromaWidth, i);
+
+        padSums(sums, chromaWidth);
+
+        interpolateSse4(sums, dst, chromaWidth);
+    }
+
+    KLARITY_TARGET("sse4.1")
+    void nv12ChromaSse4(
+            const uint8_t *near,
+            const uint8_t *far,
+            const int chromaWidth,
+            uint16_t *uSums,
+            uint16_t *vSums,
+            uint8_t *u,
+            uint8_t *v
+    ) {
+        const auto three = _mm_set1_epi16(3);
+
+        const auto mask = _mm_set1_epi16(0xFF);
+
+        int i = 0;
+
+        for (; i + 8 <= chromaWidth; i += 8) {
+            const auto nearValues = _mm_loadu_si128(reinterpret_cast<const __m128i *>(near + i * 2));
+
+            const auto farValues = _mm_loadu_si128(reinterpret_cast<const __m128i *>(far + i * 2));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(uSums + i + 1), _mm_add_epi16(
+                    _mm_mullo_epi16(_mm_and_si128(nearValues, mask), three),
+                    _mm_and_si128(farValues, mask)
+            ));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(vSums + i + 1), _mm_add_epi16(
+                    _mm_mullo_epi16(_mm_srli_epi16(nearValues, 8), three),
+                    _mm_srli_epi16(farValues, 8)
+            ));
+        }
+
+        blendNV12Scalar(near, far, uSums, vSums, chromaWidth, i);
+
+        padSums(uSums, chromaWidth);
+
+        padSums(vSums, chromaWidth);
+
+        interpolateSse4(uSums, u, chromaWidth);
+
+        interpolateSse4(vSums, v, chromaWidth);
+    }
+
+    KLARITY_TARGET("avx2")
+    inline __m256i packBgraAvx2(__m256i y, __m256i u, __m256i v) {
+        const auto luma = _mm256_add_epi32(
+                _mm256_mullo_epi32(_mm256_sub_epi32(y, _mm256_set1_epi32(Y_OFFSET)), _mm256_set1_epi32(Y_COEFFICIENT)),
+                _mm256_set1_epi32(ROUNDING)
+        );
+
+        const auto d = _mm256_sub_epi32(u, _mm256_set1_epi32(UV_OFFSET));
+
+        const auto e = _mm256_sub_epi32(v, _mm256_set1_epi32(UV_OFFSET));
+
+        const auto zero = _mm256_setzero_si256();
+
+        const auto max = _mm256_set1_epi32(255);
+
+        auto r = _mm256_srai_epi32(
+                _mm256_add_epi32(luma, _mm256_mullo_epi32(e, _mm256_set1_epi32(V_TO_R_COEFFICIENT))),
+                PRECISION
+        );
+
+        auto g = _mm256_srai_epi32(_mm256_sub_epi32(_mm256_sub_epi32(
+                luma,
+                _mm256_mullo_epi32(d, _mm256_set1_epi32(U_TO_G_COEFFICIENT))
+        ), _mm256_mullo_epi32(e, _mm256_set1_epi32(V_TO_G_COEFFICIENT))), PRECISION);
+
+        auto b = _mm256_srai_epi32(
+                _mm256_add_epi32(luma, _mm256_mullo_epi32(d, _mm256_set1_epi32(U_TO_B_COEFFICIENT))),
+                PRECISION
+        );
+
+        r = _mm256_min_epi32(_mm256_max_epi32(r, zero), max);
+
+        g = _mm256_min_epi32(_mm256_max_epi32(g, zero), max);
+
+        b = _mm256_min_epi32(_mm256_max_epi32(b, zero), max);
+
+        return _mm256_or_si256(
+                _mm256_or_si256(b, _mm256_slli_epi32(g, 8)),
+                _mm256_or_si256(_mm256_slli_epi32(r, 16), _mm256_set1_epi32(static_cast<int>(0xFF000000u)))
+        );
+    }
+
+    KLARITY_TARGET("avx2")
+    void rowAvx2(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *dst, const int width) {
+        int x = 0;
+
+        for (; x + 8 <= width; x += 8) {
+            const auto yValues = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(y + x)));
+
+            const auto uValues = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(u + x)));
+
+            const auto vValues = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(v + x)));
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + x * 4), packBgraAvx2(yValues, uValues, vValues));
+        }
+
+        rowScalar(y, u, v, dst, width, x);
+    }
+
+    KLARITY_TARGET("avx2")
+    void interpolateAvx2(const uint16_t *sums, uint8_t *dst, const int chromaWidth) {
+        const auto bias = _mm256_set1_epi16(8);
+
+        int i = 0;
+
+        for (; i + 16 <= chromaWidth; i += 16) {
+            const auto left = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(sums + i));
+
+            const auto center = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(sums + i + 1));
+
+            const auto right = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(sums + i + 2));
+
+            const auto weighted = _mm256_add_epi16(_mm256_add_epi16(center, _mm256_slli_epi16(center, 1)), bias);
+
+            const auto even = _mm256_srli_epi16(_mm256_add_epi16(weighted, left), 4);
+
+            const auto odd = _mm256_srli_epi16(_mm256_add_epi16(weighted, right), 4);
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i * 2), _mm256_or_si256(even, _mm256_slli_epi16(odd, 8)));
+        }
+
+        interpolateScalar(sums, dst, chromaWidth, i);
+    }
+
+    KLARITY_TARGET("avx2")
+    void planeChromaAvx2(const uint8_t *near, const uint8_t *far, const int chromaWidth, uint16_t *sums, uint8_t *dst) {
+        const auto three = _mm256_set1_epi16(3);
+
+        int i = 0;
+
+        for (; i + 16 <= chromaWidth; i += 16) {
+            const auto nearValues = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(near + i)));
+
+            const auto farValues = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(far + i)));
+
+            _mm256_storeu_si256(
+                    reinterpret_cast<__m256i *>(sums + i + 1),
+                    _mm256_add_epi16(_mm256_mullo_epi16(nearValues, three), farValues)
+            );
+        }
+
+        blendPlaneScalar(near, far, sums, chromaWidth, i);
+
+        padSums(sums, chromaWidth);
+
+        interpolateAvx2(sums, dst, chromaWidth);
+    }
+
+    KLARITY_TARGET("avx2")
+    void nv12ChromaAvx2(
+            const uint8_t *near,
+            const uint8_t *far,
+            const int chromaWidth,
+            uint16_t *uSums,
+            uint16_t *vSums,
+            uint8_t *u,
+            uint8_t *v
+    ) {
+        const auto three = _mm256_set1_epi16(3);
+
+        const auto mask = _mm256_set1_epi16(0xFF);
+
+        int i = 0;
+
+        for (; i + 16 <= chromaWidth; i += 16) {
+            const auto nearValues = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(near + i * 2));
+
+            const auto farValues = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(far + i * 2));
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(uSums + i + 1), _mm256_add_epi16(
+                    _mm256_mullo_epi16(_mm256_and_si256(nearValues, mask), three),
+                    _mm256_and_si256(farValues, mask)
+            ));
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(vSums + i + 1), _mm256_add_epi16(
+                    _mm256_mullo_epi16(_mm256_srli_epi16(nearValues, 8), three),
+                    _mm256_srli_epi16(farValues, 8)
+            ));
+        }
+
+        blendNV12Scalar(near, far, uSums, vSums, chromaWidth, i);
+
+        padSums(uSums, chromaWidth);
+
+        padSums(vSums, chromaWidth);
+
+        interpolateAvx2(uSums, u, chromaWidth);
+
+        interpolateAvx2(vSums, v, chromaWidth);
+    }
+
+#elif defined(KLARITY_CONVERT_NEON)
+
+    inline uint32x4_t packBgraNeon(int32x4_t y, int32x4_t u, int32x4_t v) {
+        const auto luma = vaddq_s32(
+                vmulq_n_s32(vsubq_s32(y, vdupq_n_s32(Y_OFFSET)), Y_COEFFICIENT),
+                vdupq_n_s32(ROUNDING)
+        );
+
+        const auto d = vsubq_s32(u, vdupq_n_s32(UV_OFFSET));
+
+        const auto e = vsubq_s32(v, vdupq_n_s32(UV_OFFSET));
+
+        const auto zero = vdupq_n_s32(0);
+
+        const auto max = vdupq_n_s32(255);
+
+        auto r = vshrq_n_s32(vmlaq_n_s32(luma, e, V_TO_R_COEFFICIENT), PRECISION);
+
+        auto g = vshrq_n_s32(vmlsq_n_s32(vmlsq_n_s32(luma, d, U_TO_G_COEFFICIENT), e, V_TO_G_COEFFICIENT), PRECISION);
+
+        auto b = vshrq_n_s32(vmlaq_n_s32(luma, d, U_TO_B_COEFFICIENT), PRECISION);
+
+        r = vminq_s32(vmaxq_s32(r, zero), max);
+
+        g = vminq_s32(vmaxq_s32(g, zero), max);
+
+        b = vminq_s32(vmaxq_s32(b, zero), max);
+
+        return vorrq_u32(
+                vorrq_u32(vreinterpretq_u32_s32(b), vshlq_n_u32(vreinterpretq_u32_s32(g), 8)),
+                vorrq_u32(vshlq_n_u32(vreinterpretq_u32_s32(r), 16), vdupq_n_u32(0xFF000000u))
+        );
+    }
+
+    inline void storeBgraNeon(uint8x8_t y, uint8x8_t u, uint8x8_t v, uint8_t *dst) {
+        const auto y16 = vreinterpretq_s16_u16(vmovl_u8(y));
+
+        const auto u16 = vreinterpretq_s16_u16(vmovl_u8(u));
+
+        const auto v16 = vreinterpretq_s16_u16(vmovl_u8(v));
+
+        vst1q_u32(reinterpret_cast<uint32_t *>(dst), packBgraNeon(
+                vmovl_s16(vget_low_s16(y16)),
+                vmovl_s16(vget_low_s16(u16)),
+                vmovl_s16(vget_low_s16(v16))
+        ));
+
+        vst1q_u32(reinterpret_cast<uint32_t *>(dst + 16), packBgraNeon(
+                vmovl_s16(vget_high_s16(y16)),
+                vmovl_s16(vget_high_s16(u16)),
+                vmovl_s16(vget_high_s16(v16))
+        ));
+    }
+
+    void rowNeon(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *dst, const int width) {
+        int x = 0;
+
+        for (; x + 8 <= width; x += 8) {
+            storeBgraNeon(vld1_u8(y + x), vld1_u8(u + x), vld1_u8(v + x), dst + x * 4);
+        }
+
+        rowScalar(y, u, v, dst, width, x);
+    }
+
+    void interpolateNeon(const uint16_t *sums, uint8_t *dst, const int chromaWidth) {
+        const auto bias = vdupq_n_u16(8);
+
+        int i = 0;
+
+        for (; i + 8 <= chromaWidth; i += 8) {
+            const auto weighted = vmlaq_n_u16(bias, vld1q_u16(sums + i + 1), 3);
+
+            uint8x8x2_t interleaved;
+
+            interleaved.val[0] = vshrn_n_u16(vaddq_u16(weighted, vld1q_u16(sums + i)), 4);
+
+            interleaved.val[1] = vshrn_n_u16(vaddq_u16(weighted, vld1q_u16(sums + i + 2)), 4);
+
+            vst2_u8(dst + i * 2, interleaved);
+        }
+
+        interpolateScalar(sums, dst, chromaWidth, i);
+    }
+
+    void planeChromaNeon(const uint8_t *near, const uint8_t *far, const int chromaWidth, uint16_t *sums, uint8_t *dst) {
+        const auto three = vdup_n_u8(3);
+
+        int i = 0;
+
+        for (; i + 8 <= chromaWidth; i += 8) {
+            vst1q_u16(sums + i + 1, vmlal_u8(vmovl_u8(vld1_u8(far + i)), vld1_u8(near + i), three));
+        }
+
+        blendPlaneScalar(near, far, sums, chromaWidth, i);
+
+        padSums(sums, chromaWidth);
+
+        interpolateNeon(sums, dst, chromaWidth);
+    }
+
+    void nv12ChromaNeon(
+            const uint8_t *near,
+            const uint8_t *far,
+            const int chromaWidth,
+            uint16_t *uSums,
+            uint16_t *vSums,
+            uint8_t *u,
+            uint8_t *v
+    ) {
+        const auto three = vdup_n_u8(3);
+
+        int i = 0;
+
+        for (; i + 8 <= chromaWidth; i += 8) {
+            const auto nearValues = vld2_u8(near + i * 2);
+
+            const auto farValues = vld2_u8(far + i * 2);
+
+            vst1q_u16(uSums + i + 1, vmlal_u8(vmovl_u8(farValues.val[0]), nearValues.val[0], three));
+
+            vst1q_u16(vSums + i + 1, vmlal_u8(vmovl_u8(farValues.val[1]), nearValues.val[1], three));
+        }
+
+        blendNV12Scalar(near, far, uSums, vSums, chromaWidth, i);
+
+        padSums(uSums, chromaWidth);
+
+        padSums(vSums, chromaWidth);
+
+        interpolateNeon(uSums, u, chromaWidth);
+
+        interpolateNeon(vSums, v, chromaWidth);
+    }
+
+#endif
+}
+
+ColorConversion::Kernels ColorConversion::selectKernels(const int cpuFlags) {
+#if defined(KLARITY_CONVERT_X86)
+    if (cpuFlags & AV_CPU_FLAG_AVX2) {
+        return {rowAvx2, planeChromaAvx2, nv12ChromaAvx2};
+    }
+
+    if (cpuFlags & AV_CPU_FLAG_SSE4) {
+        return {rowSse4, planeChromaSse4, nv12ChromaSse4};
+    }
+#elif defined(KLARITY_CONVERT_NEON)
+    if (cpuFlags & AV_CPU_FLAG_NEON) {
+        return {rowNeon, planeChromaNeon, nv12ChromaNeon};
+    }
+#endif
+    return {rowFallback, planeChromaFallback, nv12ChromaFallback};
+}
+
+#if defined(KLARITY_BENCHMARK)
+ColorConversion::Kernels ColorConversion::kernels = selectKernels(av_get_cpu_flags());
+
+void ColorConversion::setCpuFlags(const int cpuFlags) {
+    kernels = selectKernels(cpuFlags);
+}
+#else
+const ColorConversion::Kernels ColorConversion::kernels = selectKernels(av_get_cpu_flags());
+#endif
+
+bool ColorConversion::isSupported(const AVPixelFormat srcFormat, const AVPixelFormat dstFormat) {
+    if (kernels.row == rowFallback) {
+        return false;
+    }
+
+    return dstFormat == AV_PIX_FMT_BGRA && srcFormat == AV_PIX_FMT_NV12;
+}
+
+void ColorConversion::convertToBgra(
+        const uint8_t *const src[],
+        const int srcLinesize[],
+        const AVPixelFormat srcFormat,
+        const int width,
+        const int height,
+        const int rowBegin,
+        const int rowEnd,
+        uint8_t *dst,
+        const int dstLinesize
+) {
+    const auto chromaWidth = (width + 1) / 2;
+
+    const auto lastChromaRow = (height + 1) / 2 - 1;
+
+    thread_local std::vector<uint16_t> sums;
+
+    thread_local std::vector<uint8_t> chroma;
+
+    sums.resize(static_cast<size_t>(chromaWidth + 2) * 2);
+
+    chroma.resize(static_cast<size_t>(chromaWidth) * 4);
+
+    const auto uSums = sums.data();
+
+    const auto vSums = sums.data() + chromaWidth + 2;
+
+    const auto u = chroma.data();
+
+    const auto v = chroma.data() + chromaWidth * 2;
+
+    for (int r = rowBegin; r < rowEnd; ++r) {
+        const auto nearRow = r >> 1;
+
+        const auto farRow = std::clamp(r & 1 ? nearRow + 1 : nearRow - 1, 0, lastChromaRow);
+
+        const auto nearU = src[1] + static_cast<ptrdiff_t>(nearRow) * srcLinesize[1];
+
+        const auto farU = src[1] + static_cast<ptrdiff_t>(farRow) * srcLinesize[1];
+
+        if (srcFormat == AV_PIX_FMT_NV12) {
+            kernels.nv12Chroma(nearU, farU, chromaWidth, uSums, vSums, u, v);
+        } else {
+            kernels.planeChroma(nearU, farU, chromaWidth, uSums, u);
+
+            kernels.planeChroma(
+                    src[2] + static_cast<ptrdiff_t>(nearRow) * srcLinesize[2],
+                    src[2] + static_cast<ptrdiff_t>(farRow) * srcLinesize[2],
+                    chromaWidth,
+                    vSums,
+                    v
+            );
+        }
+
+        kernels.row(
+                src[0] + static_cast<ptrdiff_t>(r) * srcLinesize[0],
+                u,
+                v,
+                dst + static_cast<ptrdiff_t>(r) * dstLinesize,
+                width
+        );
+    }
+}
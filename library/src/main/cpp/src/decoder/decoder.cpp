@@ -86,7 +86,299 @@ bool Decoder::_prepareHardwareAcceleration(const uint32_t deviceType) {
     return false;
 }
 
-int Decoder::_processAudio() {
+std::deque<std::unique_ptr<AVPacket, AVPacketDeleter>> *Decoder::_getPacketQueue(const int streamIndex) {
+    if (audioStream && streamIndex == audioStream->index && _hasAudio()) {
+        return &audioPackets;
+    }
+
+    if (videoStream && streamIndex == videoStream->index && _hasVideo()) {
+        return &videoPackets;
+    }
+
+    return nullptr;
+}
+
+void Decoder::_queuePacket(AVPacket *src) {
+    auto queue = _getPacketQueue(src->stream_index);
+
+    if (!queue) {
+        av_packet_unref(src);
+
+        return;
+    }
+
+    if (queue->size() >= MAX_QUEUED_PACKETS) {
+        av_packet_unref(src);
+
+        throw DecoderException("Packet queue overflow, the other stream is not being consumed");
+    }
+
+    std::unique_ptr<AVPacket, AVPacketDeleter> queuedPacket;
+
+    if (!sparePackets.empty()) {
+        queuedPacket = std::move(sparePackets.back());
+
+        sparePackets.pop_back();
+    } else {
+        queuedPacket = std::unique_ptr<AVPacket, AVPacketDeleter>(av_packet_alloc());
+
+        if (!queuedPacket) {
+            av_packet_unref(src);
+
+            throw DecoderException("Memory allocation failed for queued packet");
+        }
+    }
+
+    av_packet_move_ref(queuedPacket.get(), src);
+
+    queue->push_back(std::move(queuedPacket));
+}
+
+bool Decoder::_readPacket(const AVStream *stream) {
+    av_packet_unref(packet.get());
+
+    auto queue = _getPacketQueue(stream->index);
+
+    if (queue && !queue->empty()) {
+        auto queuedPacket = std::move(queue->front());
+
+        queue->pop_front();
+
+        av_packet_move_ref(packet.get(), queuedPacket.get());
+
+        sparePackets.push_back(std::move(queuedPacket));
+
+        return true;
+    }
+
+    while (av_read_frame(formatContext.get(), packet.get()) >= 0) {
+        if (packet->stream_index == stream->index) {
+            return true;
+        }
+
+        _queuePacket(packet.get());
+    }
+
+    return false;
+}
+
+void Decoder::_clearPackets() {
+    for (auto queue: {&audioPackets, &videoPackets}) {
+        while (!queue->empty()) {
+            av_packet_unref(queue->front().get());
+
+            sparePackets.push_back(std::move(queue->front()));
+
+            queue->pop_front();
+        }
+    }
+}
+
+bool Decoder::_receiveAudioFrame(AVFrame *dst) {
+    while (true) {
+        int ret = avcodec_receive_frame(audioCodecContext.get(), dst);
+
+        if (ret == 0) {
+            return true;
+        }
+
+        if (ret == AVERROR_EOF) {
+            return false;
+        }
+
+        if (ret != AVERROR(EAGAIN)) {
+            throw DecoderException("Error receiving audio frame");
+        }
+
+        if (!_readPacket(audioStream)) {
+            return false;
+        }
+
+        avcodec_send_packet(audioCodecContext.get(), packet.get());
+
+        av_packet_unref(packet.get());
+    }
+}
+
+bool Decoder::_receiveVideoFrame(AVFrame *dst) {
+    auto receivedFrame = _isHardwareAccelerated() ? hwVideoFrame.get() : dst;
+
+    while (true) {
+        int ret = avcodec_receive_frame(videoCodecContext.get(), receivedFrame);
+
+        if (ret == 0) {
+            break;
+        }
+
+        if (ret == AVERROR_EOF) {
+            return false;
+        }
+
+        if (ret != AVERROR(EAGAIN)) {
+            throw DecoderException("Error receiving video frame");
+        }
+
+        if (!_readPacket(videoStream)) {
+            return false;
+        }
+
+        avcodec_send_packet(videoCodecContext.get(), packet.get());
+
+        av_packet_unref(packet.get());
+    }
+
+    if (_isHardwareAccelerated()) {
+        if (av_hwframe_transfer_data(dst, hwVideoFrame.get(), 0) < 0) {
+            av_frame_unref(hwVideoFrame.get());
+
+            throw DecoderException("Error transferring frame to system memory");
+        }
+
+        if (dst->format == AV_PIX_FMT_NONE || !dst->data[0]) {
+            av_frame_unref(hwVideoFrame.get());
+
+            throw DecoderException("Error transferring frame data");
+        }
+
+        dst->best_effort_timestamp = hwVideoFrame->best_effort_timestamp;
+
+        dst->pts = hwVideoFrame->pts;
+
+        av_frame_unref(hwVideoFrame.get());
+    }
+
+    return true;
+}
+
+void Decoder::_runWorker() {
+    try {
+        while (!isWorkerStopRequested.load(std::memory_order_acquire)) {
+            bool isProduced = false;
+
+            if (audioFrames && !isAudioEndOfStream.load(std::memory_order_acquire)) {
+                if (auto slot = audioFrames->acquire()) {
+                    if (_receiveAudioFrame(slot)) {
+                        audioFrames->publish();
+                    } else {
+                        isAudioEndOfStream.store(true, std::memory_order_release);
+                    }
+
+                    isProduced = true;
+                }
+            }
+
+            if (videoFrames && !isVideoEndOfStream.load(std::memory_order_acquire)) {
+                if (auto slot = videoFrames->acquire()) {
+                    if (_receiveVideoFrame(slot)) {
+                        videoFrames->publish();
+                    } else {
+                        isVideoEndOfStream.store(true, std::memory_order_release);
+                    }
+
+                    isProduced = true;
+                }
+            }
+
+            std::unique_lock<std::mutex> lock(workerMutex);
+
+            if (isProduced) {
+                workerCondition.notify_all();
+
+                continue;
+            }
+
+            workerCondition.wait(lock, [this] {
+                return isWorkerStopRequested.load(std::memory_order_acquire) ||
+                       (audioFrames && !isAudioEndOfStream.load(std::memory_order_acquire) &&
+                        !audioFrames->isFull()) ||
+                       (videoFrames && !isVideoEndOfStream.load(std::memory_order_acquire) &&
+                        !videoFrames->isFull());
+            });
+        }
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(workerMutex);
+
+        workerException = std::current_exception();
+
+        isAudioEndOfStream.store(true, std::memory_order_release);
+
+        isVideoEndOfStream.store(true, std::memory_order_release);
+
+        workerCondition.notify_all();
+    }
+}
+
+void Decoder::_startWorker() {
+    if (!audioFrames && !videoFrames) {
+        return;
+    }
+
+    isWorkerStopRequested.store(false, std::memory_order_release);
+
+    isAudioEndOfStream.store(false, std::memory_order_release);
+
+    isVideoEndOfStream.store(false, std::memory_order_release);
+
+    workerException = nullptr;
+
+    worker = std::thread(&Decoder::_runWorker, this);
+}
+
+void Decoder::_stopWorker() {
+    if (!worker.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(workerMutex);
+
+        isWorkerStopRequested.store(true, std::memory_order_release);
+
+        workerCondition.notify_all();
+    }
+
+    worker.join();
+
+    if (audioFrames) {
+        audioFrames->clear();
+    }
+
+    if (videoFrames) {
+        videoFrames->clear();
+    }
+}
+
+AVFrame *Decoder::_awaitFrame(FrameRing &frames, const std::atomic<bool> &isEndOfStream) {
+    if (auto frame = frames.peek()) {
+        return frame;
+    }
+
+    std::unique_lock<std::mutex> lock(workerMutex);
+
+    workerCondition.wait(lock, [&] {
+        return !frames.isEmpty() || isEndOfStream.load(std::memory_order_acquire);
+    });
+
+    if (auto frame = frames.peek()) {
+        return frame;
+    }
+
+    if (workerException) {
+        std::rethrow_exception(workerException);
+    }
+
+    return nullptr;
+}
+
+void Decoder::_releaseFrame(FrameRing &frames) {
+    frames.release();
+
+    std::lock_guard<std::mutex> lock(workerMutex);
+
+    workerCondition.notify_all();
+}
+
+int Decoder::_getAudioOutputSize() {
     if (!audioFrame || !swrContext) {
         throw DecoderException("Invalid audio processing state");
     }
@@ -105,7 +397,7 @@ int Decoder::_processAudio() {
 
     int bufferSize = av_samples_get_buffer_size(
             nullptr,
-            audioCodecContext->ch_layout.nb_channels,
+            format.channels,
             outSamples,
             targetSampleFormat,
             1
@@ -115,19 +407,25 @@ int Decoder::_processAudio() {
         throw DecoderException("Invalid buffer size calculation");
     }
 
-    bufferSize += AV_INPUT_BUFFER_PADDING_SIZE;
+    return bufferSize;
+}
+
+int Decoder::_processAudio(uint8_t *buffer, const int capacity) {
+    const auto bufferSize = _getAudioOutputSize();
 
-    if (audioBuffer.size() < bufferSize) {
-        audioBuffer.resize(bufferSize);
+    if (bufferSize > capacity) {
+        throw DecoderException("Insufficient buffer capacity");
     }
 
-    auto ptr = audioBuffer.data();
+    auto src = audioFrame.get();
+
+    const int outSamples = swr_get_out_samples(swrContext.get(), src->nb_samples);
 
     const int convertedSamples = swr_convert(
             swrContext.get(),
-            &ptr,
+            _getAudioPlanes(buffer, outSamples, 0),
             outSamples,
-            const_cast<const uint8_t **>(src->data),
+            const_cast<const uint8_t **>(src->extended_data),
             src->nb_samples
     );
 
@@ -135,9 +433,11 @@ int Decoder::_processAudio() {
         throw DecoderException("Audio conversion failed");
     }
 
+    _compactAudioPlanes(buffer, outSamples, convertedSamples);
+
     int actualSize = av_samples_get_buffer_size(
             nullptr,
-            audioCodecContext->ch_layout.nb_channels,
+            format.channels,
             convertedSamples,
             targetSampleFormat,
             1
@@ -150,7 +450,255 @@ int Decoder::_processAudio() {
     return actualSize;
 }
 
-int Decoder::_processVideo(uint8_t *buffer) {
+void Decoder::_updateVideoOutputFormat() {
+    if (av_image_fill_linesizes(format.videoStrides, targetPixelFormat, outputWidth) < 0) {
+        throw DecoderException("Invalid video strides");
+    }
+
+    int videoBufferCapacity = av_image_get_buffer_size(targetPixelFormat, outputWidth, outputHeight, 1);
+
+    if (videoBufferCapacity <= 0) {
+        throw DecoderException("Invalid video buffer capacity");
+    }
+
+    videoBufferCapacity += AV_INPUT_BUFFER_PADDING_SIZE;
+
+    format.videoBufferCapacity = videoBufferCapacity;
+}
+
+void Decoder::_setOutputSize(const int width, const int height) {
+    if (width == outputWidth && height == outputHeight) {
+        return;
+    }
+
+    outputWidth = width;
+
+    outputHeight = height;
+
+    _updateVideoOutputFormat();
+
+    swsWidth = -1;
+
+    swsHeight = -1;
+
+    swsPixelFormat = AV_PIX_FMT_NONE;
+
+    swsBandContexts.clear();
+}
+
+KeyframeIndex &Decoder::_getKeyframeIndex() {
+    if (!keyframeIndex) {
+        keyframeIndex = std::make_shared<KeyframeIndex>(
+                format.location,
+                formatContext->streams[videoStream->index],
+                format.frameRate
+        );
+    }
+
+    return *keyframeIndex;
+}
+
+int Decoder::_getAutoThreadCount(const AVCodecContext *codecContext) const {
+    if (codecContext->codec_type != AVMEDIA_TYPE_VIDEO) {
+        return 1;
+    }
+
+    if (codecContext->hw_device_ctx) {
+        return 1;
+    }
+
+    auto pixels = static_cast<int64_t>(codecContext->width) * codecContext->height;
+
+    switch (codecContext->codec_id) {
+        case AV_CODEC_ID_HEVC:
+        case AV_CODEC_ID_VP9:
+        case AV_CODEC_ID_AV1:
+            pixels *= 2;
+
+            break;
+
+        default:
+            break;
+    }
+
+    const auto wanted = static_cast<int>(std::clamp<int64_t>(pixels / (640 * 360), 1, MAX_VIDEO_THREADS));
+
+    const auto concurrency = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+    const auto decoders = activeVideoDecoders.load(std::memory_order_relaxed) + 1;
+
+    return std::clamp(wanted, 1, std::max(1, concurrency / decoders));
+}
+
+void Decoder::_configureThreading(
+        AVCodecContext *codecContext,
+        const AVCodec *codec,
+        const int threadCount,
+        const ThreadType threadType,
+        const DecodingProfile decodingProfile
+) const {
+    const auto canFrame = (codec->capabilities & AV_CODEC_CAP_FRAME_THREADS) != 0;
+
+    const auto canSlice = (codec->capabilities & AV_CODEC_CAP_SLICE_THREADS) != 0;
+
+    auto type = threadType;
+
+    if (type == ThreadType::AUTO) {
+        if (decodingProfile == DecodingProfile::THROUGHPUT && canFrame) {
+            type = ThreadType::FRAME;
+        } else {
+            type = canSlice ? ThreadType::SLICE : ThreadType::NONE;
+        }
+    }
+
+    if ((type == ThreadType::FRAME && !canFrame) || (type == ThreadType::SLICE && !canSlice)) {
+        type = ThreadType::NONE;
+    }
+
+    const auto maxThreads = codecContext->codec_type == AVMEDIA_TYPE_VIDEO ? MAX_VIDEO_THREADS : MAX_AUDIO_THREADS;
+
+    const auto count = threadCount > 0 ? std::min(threadCount, maxThreads) : _getAutoThreadCount(codecContext);
+
+    switch (type) {
+        case ThreadType::FRAME:
+            codecContext->thread_type = FF_THREAD_FRAME;
+
+            codecContext->thread_count = count;
+
+            break;
+
+        case ThreadType::SLICE:
+            codecContext->thread_type = FF_THREAD_SLICE;
+
+            codecContext->thread_count = count;
+
+            break;
+
+        default:
+            codecContext->thread_count = 1;
+
+            break;
+    }
+
+    if (decodingProfile == DecodingProfile::LATENCY && type != ThreadType::FRAME) {
+        codecContext->flags |= AV_CODEC_FLAG_LOW_DELAY;
+    }
+}
+
+int Decoder::_getBandCount(const int width, const int height) const {
+    if (static_cast<int64_t>(width) * height < MIN_BAND_PIXELS) {
+        return 1;
+    }
+
+    return std::clamp(height / MIN_BAND_HEIGHT, 1, WorkerPool::getShared().getConcurrency());
+}
+
+void Decoder::_offsetPlanes(
+        const AVPixFmtDescriptor *descriptor,
+        uint8_t *const data[4],
+        const int linesize[4],
+        const int row,
+        uint8_t *planes[4]
+) {
+    for (int plane = 0; plane < 4; ++plane) {
+        if (!data[plane]) {
+            planes[plane] = nullptr;
+
+            continue;
+        }
+
+        const auto planeRow = (plane == 1 || plane == 2) ? row >> descriptor->log2_chroma_h : row;
+
+        planes[plane] = data[plane] + static_cast<ptrdiff_t>(planeRow) * linesize[plane];
+    }
+}
+
+void Decoder::_scaleBands(const AVFrame *src, uint8_t *const dst[4], const int dstLinesize[4], const int bandCount) {
+    const auto srcPixelFormat = static_cast<AVPixelFormat>(src->format);
+
+    const auto srcDescriptor = av_pix_fmt_desc_get(srcPixelFormat);
+
+    const auto dstDescriptor = av_pix_fmt_desc_get(targetPixelFormat);
+
+    if (!srcDescriptor || !dstDescriptor) {
+        throw DecoderException("Unsupported pixel format");
+    }
+
+    const int alignment = 1 << std::max(srcDescriptor->log2_chroma_h, dstDescriptor->log2_chroma_h);
+
+    const auto dstWidth = outputWidth;
+
+    const auto dstHeight = outputHeight;
+
+    auto bandRow = [&](const int band, const int height) {
+        return band == bandCount ? height : height * band / bandCount / alignment * alignment;
+    };
+
+    if (swsBandContexts.size() != static_cast<size_t>(bandCount) ||
+        src->width != swsBandWidth ||
+        src->height != swsBandHeight ||
+        srcPixelFormat != swsBandPixelFormat) {
+        swsBandContexts.resize(bandCount);
+
+        for (int band = 0; band < bandCount; ++band) {
+            auto newContext = sws_getCachedContext(
+                    swsBandContexts[band].release(),
+                    src->width,
+                    bandRow(band + 1, src->height) - bandRow(band, src->height),
+                    srcPixelFormat,
+                    dstWidth,
+                    bandRow(band + 1, dstHeight) - bandRow(band, dstHeight),
+                    targetPixelFormat,
+                    swsFlags,
+                    nullptr,
+                    nullptr,
+                    nullptr
+            );
+
+            if (!newContext) {
+                swsBandContexts.clear();
+
+                throw DecoderException("Could not allocate sws band context");
+            }
+
+            swsBandContexts[band].reset(newContext);
+        }
+
+        swsBandWidth = src->width;
+
+        swsBandHeight = src->height;
+
+        swsBandPixelFormat = srcPixelFormat;
+    }
+
+    WorkerPool::getShared().run(bandCount, [&](const int band) {
+        const auto srcRow = bandRow(band, src->height);
+
+        const auto dstRow = bandRow(band, dstHeight);
+
+        uint8_t *srcPlanes[4];
+
+        uint8_t *dstPlanes[4];
+
+        _offsetPlanes(srcDescriptor, src->data, src->linesize, srcRow, srcPlanes);
+
+        _offsetPlanes(dstDescriptor, dst, dstLinesize, dstRow, dstPlanes);
+
+        if (sws_scale(
+                swsBandContexts[band].get(),
+                srcPlanes,
+                src->linesize,
+                0,
+                bandRow(band + 1, src->height) - srcRow,
+                dstPlanes,
+                dstLinesize
+        ) <= 0) {
+            throw DecoderException("Video conversion failed");
+        }
+    });
+}
+
+int Decoder::_processVideo(uint8_t *buffer, const int capacity) {
     if (!swVideoFrame || !swsContext) {
         throw DecoderException("Invalid video processing state");
     }
@@ -165,14 +713,98 @@ int Decoder::_processVideo(uint8_t *buffer) {
         throw DecoderException("Invalid source video frame data");
     }
 
+    int actualSize = av_image_get_buffer_size(
+            targetPixelFormat,
+            outputWidth,
+            outputHeight,
+            1
+    );
+
+    if (actualSize <= 0) {
+        throw DecoderException("Invalid converted video size");
+    }
+
+    if (actualSize > capacity) {
+        throw DecoderException("Insufficient buffer capacity");
+    }
+
+    if (src->format == targetPixelFormat &&
+        src->width == outputWidth &&
+        src->height == outputHeight) {
+        if (av_image_copy_to_buffer(
+                buffer,
+                capacity,
+                src->data,
+                src->linesize,
+                targetPixelFormat,
+                src->width,
+                src->height,
+                1
+        ) < 0) {
+            throw DecoderException("Video plane copy failed");
+        }
+
+        return actualSize;
+    }
+
+    const auto isSameSize = src->width == outputWidth && src->height == outputHeight;
+
+    const auto bandCount = isSameSize ? _getBandCount(outputWidth, outputHeight) : 1;
+
+    if (ColorConversion::isSupported(static_cast<AVPixelFormat>(src->format), targetPixelFormat) && isSameSize) {
+        int linesize[4] = {0, 0, 0, 0};
+
+        if (av_image_fill_linesizes(linesize, targetPixelFormat, src->width) < 0 || linesize[0] <= 0) {
+            throw DecoderException("Invalid destination linesize");
+        }
+
+        WorkerPool::getShared().run(bandCount, [&](const int band) {
+            ColorConversion::convertToBgra(
+                    src->data,
+                    src->linesize,
+                    static_cast<AVPixelFormat>(src->format),
+                    src->width,
+                    src->height,
+                    src->height * band / bandCount,
+                    src->height * (band + 1) / bandCount,
+                    buffer,
+                    linesize[0]
+            );
+        });
+
+        return actualSize;
+    }
+
+    uint8_t *dst[4] = {nullptr, nullptr, nullptr, nullptr};
+
+    int linesize[4] = {0, 0, 0, 0};
+
+    if (av_image_fill_arrays(
+            dst,
+            linesize,
+            buffer,
+            targetPixelFormat,
+            outputWidth,
+            outputHeight,
+            1
+    ) < 0 || linesize[0] <= 0) {
+        throw DecoderException("Invalid destination linesize");
+    }
+
+    if (bandCount > 1) {
+        _scaleBands(src, dst, linesize, bandCount);
+
+        return actualSize;
+    }
+
     if (src->width != swsWidth || src->height != swsHeight || src->format != swsPixelFormat) {
         auto newContext = sws_getCachedContext(
                 swsContext.release(),
                 src->width,
                 src->height,
                 static_cast<AVPixelFormat>(src->format),
-                videoCodecContext->width,
-                videoCodecContext->height,
+                outputWidth,
+                outputHeight,
                 targetPixelFormat,
                 swsFlags,
                 nullptr,
@@ -193,16 +825,6 @@ int Decoder::_processVideo(uint8_t *buffer) {
         swsPixelFormat = static_cast<AVPixelFormat>(src->format);
     }
 
-    uint8_t *dst[4] = {buffer, nullptr, nullptr, nullptr};
-
-    int linesize[4] = {0, 0, 0, 0};
-
-    av_image_fill_linesizes(linesize, targetPixelFormat, videoCodecContext->width);
-
-    if (linesize[0] <= 0) {
-        throw DecoderException("Invalid destination linesize");
-    }
-
     if (sws_scale(
             swsContext.get(),
             src->data,
@@ -215,17 +837,6 @@ int Decoder::_processVideo(uint8_t *buffer) {
         throw DecoderException("Video conversion failed");
     }
 
-    int actualSize = av_image_get_buffer_size(
-            targetPixelFormat,
-            videoCodecContext->width,
-            videoCodecContext->height,
-            1
-    );
-
-    if (actualSize <= 0) {
-        throw DecoderException("Invalid converted video size");
-    }
-
     return actualSize;
 }
 
@@ -235,10 +846,30 @@ Decoder::Decoder(
         const bool findVideoStream,
         const bool decodeAudioStream,
         const bool decodeVideoStream,
-        const std::vector<uint32_t> &hardwareAccelerationCandidates
+        const std::vector<uint32_t> &hardwareAccelerationCandidates,
+        const int readAheadFrames,
+        const VideoOutputFormat videoOutputFormat,
+        const int threadCount,
+        const ThreadType threadType,
+        const DecodingProfile decodingProfile,
+        const int outputSampleRate,
+        const int outputChannels,
+        const AudioOutputFormat audioOutputFormat
 ) {
     std::unique_lock<std::shared_mutex> lock(mutex);
 
+    if (readAheadFrames < 0) {
+        throw DecoderException("Invalid read-ahead frame count");
+    }
+
+    if (threadCount < 0) {
+        throw DecoderException("Invalid thread count");
+    }
+
+    if (outputSampleRate < 0 || outputChannels < 0) {
+        throw DecoderException("Invalid audio output parameters");
+    }
+
     AVFormatContext *rawFormatContext = nullptr;
 
     if ((avformat_open_input(&rawFormatContext, location.c_str(), nullptr, nullptr) < 0) || !rawFormatContext) {
@@ -279,17 +910,13 @@ Decoder::Decoder(
                     throw DecoderException("Could not copy parameters to audio codec context");
                 }
 
-                if (audioDecoder->capabilities & AV_CODEC_CAP_FRAME_THREADS) {
-                    audioCodecContext->thread_type = FF_THREAD_FRAME;
-
-                    audioCodecContext->thread_count = THREAD_COUNT;
-                } else if (audioDecoder->capabilities & AV_CODEC_CAP_SLICE_THREADS) {
-                    audioCodecContext->thread_type = FF_THREAD_SLICE;
-
-                    audioCodecContext->thread_count = THREAD_COUNT;
-                }
-
-                audioCodecContext->flags |= AV_CODEC_FLAG_LOW_DELAY;
+                _configureThreading(
+                        audioCodecContext.get(),
+                        audioDecoder,
+                        threadCount,
+                        threadType,
+                        decodingProfile
+                );
 
                 if (avcodec_open2(audioCodecContext.get(), audioDecoder, nullptr) < 0) {
                     throw DecoderException("Could not open audio decoder");
@@ -309,28 +936,89 @@ Decoder::Decoder(
                 format.channels = audioCodecContext->ch_layout.nb_channels;
 
                 if (decodeAudioStream) {
+                    switch (audioOutputFormat) {
+                        case AudioOutputFormat::S16:
+                            targetSampleFormat = AV_SAMPLE_FMT_S16;
+
+                            break;
+
+                        case AudioOutputFormat::FLTP:
+                            targetSampleFormat = AV_SAMPLE_FMT_FLTP;
+
+                            break;
+
+                        default:
+                            targetSampleFormat = AV_SAMPLE_FMT_FLT;
+
+                            break;
+                    }
+
+                    AVChannelLayout outputLayout{};
+
+                    if (outputChannels > 0) {
+                        av_channel_layout_default(&outputLayout, outputChannels);
+                    } else if (av_channel_layout_copy(&outputLayout, &audioCodecContext->ch_layout) < 0) {
+                        throw DecoderException("Could not copy audio channel layout");
+                    }
+
+                    const auto outputRate = outputSampleRate > 0 ? outputSampleRate : audioCodecContext->sample_rate;
+
                     SwrContext *rawSwrContext = nullptr;
 
-                    if (swr_alloc_set_opts2(
+                    const auto isAllocated = swr_alloc_set_opts2(
                             &rawSwrContext,
-                            &audioCodecContext->ch_layout,
+                            &outputLayout,
                             targetSampleFormat,
-                            audioCodecContext->sample_rate,
+                            outputRate,
                             &audioCodecContext->ch_layout,
                             audioCodecContext->sample_fmt,
                             audioCodecContext->sample_rate,
                             0,
-                            nullptr) < 0 || !rawSwrContext
-                            ) {
+                            nullptr) >= 0 && rawSwrContext;
+
+                    format.sampleRate = outputRate;
+
+                    format.channels = outputLayout.nb_channels;
+
+                    av_channel_layout_uninit(&outputLayout);
+
+                    if (!isAllocated) {
+                        swr_free(&rawSwrContext);
+
                         throw DecoderException("Could not allocate swr context");
                     }
 
+                    format.audioSampleFormat = targetSampleFormat;
+
+                    audioPlanes.resize(std::max(format.channels, 1));
+
                     swrContext = std::unique_ptr<SwrContext, SwrContextDeleter>(rawSwrContext);
 
                     if (swr_init(swrContext.get()) < 0) {
                         throw DecoderException("Could not initialize swr context");
                     }
 
+                    const auto bufferSamples = swr_get_out_samples(
+                            swrContext.get(),
+                            std::max(audioCodecContext->frame_size, MIN_AUDIO_BUFFER_SAMPLES)
+                    );
+
+                    const auto audioBufferCapacity = av_samples_get_buffer_size(
+                            nullptr,
+                            format.channels,
+                            bufferSamples,
+                            targetSampleFormat,
+                            1
+                    );
+
+                    if (bufferSamples <= 0 || audioBufferCapacity <= 0) {
+                        throw DecoderException("Invalid audio buffer capacity");
+                    }
+
+                    audioFrameCapacity = audioBufferCapacity;
+
+                    _updateAudioBufferCapacity();
+
                     audioFrame = std::unique_ptr<AVFrame, AVFrameDeleter>(av_frame_alloc());
 
                     if (!audioFrame) {
@@ -374,24 +1062,26 @@ Decoder::Decoder(
 
                 const auto frameInterval = 1'000'000.0 / format.frameRate;
 
-                if (format.frameRate > 0) {
-                    if (static_cast<double>(format.durationMicros) > frameInterval) {
-                        if (videoDecoder->capabilities & AV_CODEC_CAP_FRAME_THREADS) {
-                            videoCodecContext->thread_type = FF_THREAD_FRAME;
-
-                            videoCodecContext->thread_count = THREAD_COUNT;
-                        } else if (videoDecoder->capabilities & AV_CODEC_CAP_SLICE_THREADS) {
-                            videoCodecContext->thread_type = FF_THREAD_SLICE;
+                auto videoThreadType = threadType;
 
-                            videoCodecContext->thread_count = THREAD_COUNT;
-                        }
-                    } else {
+                if (format.frameRate > 0) {
+                    if (static_cast<double>(format.durationMicros) <= frameInterval) {
                         format.frameRate = 0.0;
                         format.durationMicros = 0;
+
+                        videoThreadType = ThreadType::NONE;
                     }
+                } else {
+                    videoThreadType = ThreadType::NONE;
                 }
 
-                videoCodecContext->flags |= AV_CODEC_FLAG_LOW_DELAY;
+                _configureThreading(
+                        videoCodecContext.get(),
+                        videoDecoder,
+                        threadCount,
+                        videoThreadType,
+                        decodingProfile
+                );
 
                 if (avcodec_open2(videoCodecContext.get(), videoDecoder, nullptr) < 0) {
                     throw DecoderException("Could not open video decoder");
@@ -410,20 +1100,21 @@ Decoder::Decoder(
 
                 format.height = videoCodecContext->height;
 
-                int videoBufferCapacity = av_image_get_buffer_size(
-                        targetPixelFormat,
-                        videoCodecContext->width,
-                        videoCodecContext->height,
-                        1
-                );
-
-                if (videoBufferCapacity <= 0) {
-                    throw DecoderException("Invalid video buffer capacity");
+                if (videoOutputFormat == VideoOutputFormat::YUV) {
+                    if (_isHardwareAccelerated() || videoCodecContext->pix_fmt == AV_PIX_FMT_NV12) {
+                        targetPixelFormat = AV_PIX_FMT_NV12;
+                    } else {
+                        targetPixelFormat = AV_PIX_FMT_YUV420P;
+                    }
                 }
 
-                videoBufferCapacity += AV_INPUT_BUFFER_PADDING_SIZE;
+                format.videoPixelFormat = targetPixelFormat;
+
+                outputWidth = videoCodecContext->width;
 
-                format.videoBufferCapacity = videoBufferCapacity;
+                outputHeight = videoCodecContext->height;
+
+                _updateVideoOutputFormat();
 
                 if (decodeVideoStream) {
                     swsContext = std::unique_ptr<SwsContext, SwsContextDeleter>(
@@ -431,8 +1122,8 @@ Decoder::Decoder(
                                     videoCodecContext->width,
                                     videoCodecContext->height,
                                     videoCodecContext->pix_fmt,
-                                    videoCodecContext->width,
-                                    videoCodecContext->height,
+                                    outputWidth,
+                                    outputHeight,
                                     targetPixelFormat,
                                     swsFlags,
                                     nullptr,
@@ -468,11 +1159,41 @@ Decoder::Decoder(
             throw DecoderException("Memory allocation failed for packet");
         }
     }
+
+    if (readAheadFrames > 0) {
+        if (_hasAudio()) {
+            audioFrames = std::make_unique<FrameRing>(static_cast<size_t>(readAheadFrames));
+        }
+
+        if (_hasVideo()) {
+            videoFrames = std::make_unique<FrameRing>(static_cast<size_t>(readAheadFrames));
+        }
+
+        _startWorker();
+    }
+
+    if (decodeVideoStream && _hasVideo()) {
+        activeVideoDecoders.fetch_add(1, std::memory_order_relaxed);
+
+        isActiveVideoDecoder = true;
+    }
 }
 
 Decoder::~Decoder() {
     std::unique_lock<std::shared_mutex> lock(mutex);
 
+    _stopWorker();
+
+    if (isActiveVideoDecoder) {
+        activeVideoDecoders.fetch_sub(1, std::memory_order_relaxed);
+
+        isActiveVideoDecoder = false;
+    }
+
+    videoFrames.reset();
+
+    audioFrames.reset();
+
     if (videoCodecContext && videoCodecContext->hw_device_ctx) {
         HardwareAcceleration::releaseContext(videoCodecContext->hw_device_ctx);
 
@@ -485,100 +1206,396 @@ Decoder::~Decoder() {
 
     audioFrame.reset();
 
+    prerollFrame.reset();
+
+    audioPackets.clear();
+
+    videoPackets.clear();
+
+    sparePackets.clear();
+
     packet.reset();
 
+    swsBandContexts.clear();
+
     swsContext.reset();
 
     swrContext.reset();
 
     videoCodecContext.reset();
 
-    audioCodecContext.reset();
+    audioCodecContext.reset();
+
+    formatContext.reset();
+}
+
+void Decoder::_updateAudioBufferCapacity() {
+    const auto chunkCapacity = av_samples_get_buffer_size(
+            nullptr,
+            format.channels,
+            std::max(audioChunkSamples, 1),
+            targetSampleFormat,
+            1
+    );
+
+    if (chunkCapacity <= 0) {
+        throw DecoderException("Invalid audio buffer capacity");
+    }
+
+    format.audioBufferCapacity = std::max(audioFrameCapacity, chunkCapacity) + AV_INPUT_BUFFER_PADDING_SIZE;
+}
+
+void Decoder::_resetAudioConversion() {
+    pendingAudioTimestampMicros = AV_NOPTS_VALUE;
+
+    if (!swrContext) {
+        return;
+    }
+
+    swr_close(swrContext.get());
+
+    if (swr_init(swrContext.get()) < 0) {
+        throw DecoderException("Could not initialize swr context");
+    }
+}
+
+int Decoder::_decodeAudioChunk(uint8_t *buffer, const int capacity, int64_t &timestampMicros) {
+    const auto sampleSize = format.channels * av_get_bytes_per_sample(targetSampleFormat);
+
+    if (sampleSize <= 0) {
+        throw DecoderException("Invalid audio sample size");
+    }
+
+    if (static_cast<int64_t>(audioChunkSamples) * sampleSize > capacity) {
+        throw DecoderException("Insufficient buffer capacity");
+    }
+
+    const auto sampleRate = format.sampleRate;
+
+    int writtenSamples = 0;
+
+    timestampMicros = AV_NOPTS_VALUE;
+
+    if (pendingAudioTimestampMicros != AV_NOPTS_VALUE && swr_get_out_samples(swrContext.get(), 0) > 0) {
+        const uint8_t *emptyInput[AV_NUM_DATA_POINTERS] = {};
+
+        const auto convertedSamples = swr_convert(
+                swrContext.get(),
+                _getAudioPlanes(buffer, audioChunkSamples, 0),
+                audioChunkSamples,
+                emptyInput,
+                0
+        );
+
+        if (convertedSamples < 0) {
+            throw DecoderException("Audio conversion failed");
+        }
+
+        if (convertedSamples > 0) {
+            timestampMicros = pendingAudioTimestampMicros;
+
+            writtenSamples = convertedSamples;
+
+            pendingAudioTimestampMicros += av_rescale(convertedSamples, 1'000'000, sampleRate);
+        }
+    }
+
+    while (writtenSamples < audioChunkSamples) {
+        int64_t frameTimestampMicros;
+
+        if (!_decodeAudioFrame(frameTimestampMicros)) {
+            break;
+        }
+
+        if (timestampMicros == AV_NOPTS_VALUE) {
+            timestampMicros = frameTimestampMicros;
+        }
+
+        const auto convertedSamples = swr_convert(
+                swrContext.get(),
+                _getAudioPlanes(buffer, audioChunkSamples, writtenSamples),
+                audioChunkSamples - writtenSamples,
+                const_cast<const uint8_t **>(audioFrame->extended_data),
+                audioFrame->nb_samples
+        );
+
+        av_frame_unref(audioFrame.get());
+
+        if (convertedSamples < 0) {
+            throw DecoderException("Audio conversion failed");
+        }
+
+        writtenSamples += convertedSamples;
+
+        pendingAudioTimestampMicros = frameTimestampMicros + av_rescale(convertedSamples, 1'000'000, sampleRate);
+    }
+
+    _compactAudioPlanes(buffer, audioChunkSamples, writtenSamples);
+
+    return writtenSamples * sampleSize;
+}
+
+uint8_t **Decoder::_getAudioPlanes(uint8_t *buffer, const int stride, const int offset) {
+    const auto bytesPerSample = av_get_bytes_per_sample(targetSampleFormat);
+
+    if (!av_sample_fmt_is_planar(targetSampleFormat)) {
+        audioPlanes[0] = buffer + static_cast<ptrdiff_t>(offset) * format.channels * bytesPerSample;
+
+        return audioPlanes.data();
+    }
+
+    for (int channel = 0; channel < format.channels; ++channel) {
+        audioPlanes[channel] = buffer + (static_cast<ptrdiff_t>(channel) * stride + offset) * bytesPerSample;
+    }
+
+    return audioPlanes.data();
+}
+
+void Decoder::_compactAudioPlanes(uint8_t *buffer, const int stride, const int samples) const {
+    if (!av_sample_fmt_is_planar(targetSampleFormat) || samples >= stride) {
+        return;
+    }
+
+    const auto bytesPerSample = av_get_bytes_per_sample(targetSampleFormat);
+
+    for (int channel = 1; channel < format.channels; ++channel) {
+        std::memmove(
+                buffer + static_cast<ptrdiff_t>(channel) * samples * bytesPerSample,
+                buffer + static_cast<ptrdiff_t>(channel) * stride * bytesPerSample,
+                static_cast<size_t>(samples) * bytesPerSample
+        );
+    }
+}
+
+bool Decoder::_decodeAudioFrame(int64_t &timestampMicros) {
+    if (audioFrames) {
+        auto readyFrame = _awaitFrame(*audioFrames, isAudioEndOfStream);
+
+        if (!readyFrame) {
+            return false;
+        }
+
+        av_frame_move_ref(audioFrame.get(), readyFrame);
+
+        _releaseFrame(*audioFrames);
+    } else if (!_receiveAudioFrame(audioFrame.get())) {
+        return false;
+    }
+
+    const auto frameTimestampMicros = (audioFrame->best_effort_timestamp != AV_NOPTS_VALUE)
+                                      ? audioFrame->best_effort_timestamp : audioFrame->pts;
+
+    timestampMicros = av_rescale_q(
+            frameTimestampMicros,
+            audioStream->time_base,
+            AVRational{1, 1'000'000}
+    );
+
+    return true;
+}
+
+std::optional<AudioFrame> Decoder::decodeAudio() {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+
+    if (!_isValid()) {
+        throw DecoderException("Could not use uninitialized decoder");
+    }
+
+    if (!_hasAudio()) {
+        throw DecoderException("Could not find audio stream");
+    }
+
+    try {
+        int64_t timestampMicros;
+
+        int remaining;
+
+        if (audioChunkSamples > 0) {
+            if (static_cast<int>(audioBuffer.size()) < format.audioBufferCapacity) {
+                audioBuffer.resize(format.audioBufferCapacity);
+            }
+
+            remaining = _decodeAudioChunk(audioBuffer.data(), static_cast<int>(audioBuffer.size()), timestampMicros);
+
+            if (remaining <= 0) {
+                return std::nullopt;
+            }
+        } else {
+            if (!_decodeAudioFrame(timestampMicros)) {
+                return std::nullopt;
+            }
+
+            const auto bufferSize = _getAudioOutputSize() + AV_INPUT_BUFFER_PADDING_SIZE;
+
+            if (static_cast<int>(audioBuffer.size()) < bufferSize) {
+                audioBuffer.resize(bufferSize);
+            }
+
+            remaining = _processAudio(audioBuffer.data(), static_cast<int>(audioBuffer.size()));
+
+            av_frame_unref(audioFrame.get());
+        }
+
+        std::vector<uint8_t> bytes(audioBuffer.begin(), audioBuffer.begin() + remaining);
+
+        return std::optional(
+                AudioFrame{
+                        bytes,
+                        timestampMicros
+                }
+        );
+    } catch (...) {
+        if (packet && !worker.joinable()) {
+            av_packet_unref(packet.get());
+        }
+
+        if (audioFrame) {
+            av_frame_unref(audioFrame.get());
+        }
+
+        throw;
+    }
+}
+
+std::optional<AudioChunk> Decoder::decodeAudio(uint8_t *buffer, const int capacity) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+
+    if (!_isValid()) {
+        throw DecoderException("Could not use uninitialized decoder");
+    }
+
+    if (!_hasAudio()) {
+        throw DecoderException("Could not find audio stream");
+    }
+
+    if (!buffer) {
+        throw DecoderException("Invalid buffer");
+    }
+
+    if (capacity <= 0) {
+        throw DecoderException("Invalid buffer capacity");
+    }
+
+    try {
+        int64_t timestampMicros;
+
+        int remaining;
+
+        if (audioChunkSamples > 0) {
+            remaining = _decodeAudioChunk(buffer, capacity, timestampMicros);
+
+            if (remaining <= 0) {
+                return std::nullopt;
+            }
+        } else {
+            if (!_decodeAudioFrame(timestampMicros)) {
+                return std::nullopt;
+            }
+
+            remaining = _processAudio(buffer, capacity);
+
+            av_frame_unref(audioFrame.get());
+        }
+
+        return std::optional(
+                AudioChunk{
+                        remaining,
+                        timestampMicros
+                }
+        );
+    } catch (...) {
+        if (packet && !worker.joinable()) {
+            av_packet_unref(packet.get());
+        }
+
+        if (audioFrame) {
+            av_frame_unref(audioFrame.get());
+        }
 
-    formatContext.reset();
+        throw;
+    }
 }
 
-std::optional<AudioFrame> Decoder::decodeAudio() {
+std::optional<VideoFrame> Decoder::decodeVideo(uint8_t *buffer, int capacity) {
     std::unique_lock<std::shared_mutex> lock(mutex);
 
     if (!_isValid()) {
         throw DecoderException("Could not use uninitialized decoder");
     }
 
-    if (!_hasAudio()) {
-        throw DecoderException("Could not find audio stream");
+    if (!_hasVideo()) {
+        throw DecoderException("Could not find video stream");
     }
 
-    av_packet_unref(packet.get());
-
-    try {
-        while (av_read_frame(formatContext.get(), packet.get()) >= 0) {
-            if (packet->stream_index == audioStream->index) {
-                if (avcodec_send_packet(audioCodecContext.get(), packet.get()) < 0) {
-                    av_packet_unref(packet.get());
-
-                    continue;
-                }
-
-                av_packet_unref(packet.get());
+    if (!buffer) {
+        throw DecoderException("Invalid buffer");
+    }
 
-                while (true) {
-                    int ret = avcodec_receive_frame(audioCodecContext.get(), audioFrame.get());
+    if (capacity <= 0) {
+        throw DecoderException("Invalid buffer capacity");
+    }
 
-                    if (ret == AVERROR(EAGAIN)) {
-                        break;
-                    }
+    try {
+        if (videoFrames) {
+            auto readyFrame = _awaitFrame(*videoFrames, isVideoEndOfStream);
 
-                    if (ret == AVERROR_EOF) {
-                        break;
-                    }
+            if (!readyFrame) {
+                return std::nullopt;
+            }
 
-                    if (ret < 0) {
-                        throw DecoderException("Error receiving audio frame");
-                    }
+            av_frame_move_ref(swVideoFrame.get(), readyFrame);
 
-                    const auto frameTimestampMicros = (audioFrame->best_effort_timestamp != AV_NOPTS_VALUE)
-                                                      ? audioFrame->best_effort_timestamp : audioFrame->pts;
+            _releaseFrame(*videoFrames);
+        } else if (!_receiveVideoFrame(swVideoFrame.get())) {
+            return std::nullopt;
+        }
 
-                    const auto timestampMicros = av_rescale_q(
-                            frameTimestampMicros,
-                            audioStream->time_base,
-                            AVRational{1, 1'000'000}
-                    );
+        const auto frameTimestampMicros = (swVideoFrame->best_effort_timestamp != AV_NOPTS_VALUE)
+                                          ? swVideoFrame->best_effort_timestamp : swVideoFrame->pts;
 
-                    auto remaining = _processAudio();
+        auto remaining = _processVideo(buffer, capacity);
 
-                    av_frame_unref(audioFrame.get());
+        av_frame_unref(swVideoFrame.get());
 
-                    std::vector<uint8_t> bytes(audioBuffer.begin(), audioBuffer.begin() + remaining);
+        const auto timestampMicros = av_rescale_q(
+                frameTimestampMicros,
+                videoStream->time_base,
+                AVRational{1, 1'000'000}
+        );
 
-                    return std::optional(
-                            AudioFrame{
-                                    bytes,
-                                    timestampMicros
-                            }
-                    );
+        return std::optional(
+                VideoFrame{
+                        remaining,
+                        timestampMicros,
+                        outputWidth,
+                        outputHeight
                 }
-            }
-
-            av_packet_unref(packet.get());
-        }
+        );
     } catch (...) {
-        if (packet) {
+        if (packet && !worker.joinable()) {
             av_packet_unref(packet.get());
         }
 
-        if (audioFrame) {
-            av_frame_unref(audioFrame.get());
+        if (hwVideoFrame && !worker.joinable()) {
+            av_frame_unref(hwVideoFrame.get());
+        }
+
+        if (swVideoFrame) {
+            av_frame_unref(swVideoFrame.get());
         }
 
         throw;
     }
-
-    return std::nullopt;
 }
 
-std::optional<VideoFrame> Decoder::decodeVideo(uint8_t *buffer, int capacity) {
+std::vector<std::optional<VideoFrame>> Decoder::decodeThumbnails(
+        const std::vector<int64_t> &timestampsMicros,
+        const int width,
+        const int height,
+        const bool keyFramesOnly,
+        uint8_t *buffer,
+        const int capacity
+) {
     std::unique_lock<std::shared_mutex> lock(mutex);
 
     if (!_isValid()) {
@@ -589,115 +1606,141 @@ std::optional<VideoFrame> Decoder::decodeVideo(uint8_t *buffer, int capacity) {
         throw DecoderException("Could not find video stream");
     }
 
+    if (width <= 0 || height <= 0) {
+        throw DecoderException("Invalid thumbnail size");
+    }
+
     if (!buffer) {
         throw DecoderException("Invalid buffer");
     }
 
-    if (capacity <= 0) {
-        throw DecoderException("Invalid buffer capacity");
+    const auto thumbnailSize = av_image_get_buffer_size(targetPixelFormat, width, height, 1);
+
+    if (thumbnailSize <= 0) {
+        throw DecoderException("Invalid thumbnail size");
     }
 
-    av_packet_unref(packet.get());
+    if (static_cast<int64_t>(thumbnailSize) * static_cast<int64_t>(timestampsMicros.size()) > capacity) {
+        throw DecoderException("Insufficient buffer capacity");
+    }
+
+    std::vector<size_t> order(timestampsMicros.size());
+
+    std::iota(order.begin(), order.end(), 0);
+
+    std::stable_sort(order.begin(), order.end(), [&](const size_t a, const size_t b) {
+        return timestampsMicros[a] < timestampsMicros[b];
+    });
+
+    std::vector<std::optional<VideoFrame>> thumbnails(timestampsMicros.size());
+
+    const auto previousWidth = outputWidth;
+
+    const auto previousHeight = outputHeight;
+
+    const auto thresholdPts = av_rescale_q(20'000, AVRational{1, AV_TIME_BASE}, videoStream->time_base);
+
+    _stopWorker();
 
     try {
-        while (av_read_frame(formatContext.get(), packet.get()) >= 0) {
-            if (packet->stream_index == videoStream->index) {
-                if (avcodec_send_packet(videoCodecContext.get(), packet.get()) < 0) {
-                    av_packet_unref(packet.get());
+        _setOutputSize(width, height);
 
-                    continue;
-                }
+        std::optional<size_t> lastIndex;
 
-                av_packet_unref(packet.get());
+        int64_t lastPts = AV_NOPTS_VALUE;
 
-                while (true) {
-                    int ret = avcodec_receive_frame(
-                            videoCodecContext.get(),
-                            _isHardwareAccelerated() ? hwVideoFrame.get() : swVideoFrame.get()
-                    );
+        int64_t lastKeyframePts = AV_NOPTS_VALUE;
 
-                    if (ret == AVERROR(EAGAIN)) {
-                        break;
-                    }
+        for (const auto index: order) {
+            const auto timestampMicros = std::clamp<int64_t>(timestampsMicros[index], 0, format.durationMicros);
 
-                    if (ret == AVERROR_EOF) {
-                        break;
-                    }
+            const auto targetPts = av_rescale_q(timestampMicros, AVRational{1, AV_TIME_BASE}, videoStream->time_base);
 
-                    if (ret < 0) {
-                        throw DecoderException("Error receiving video frame");
-                    }
+            const auto keyframe = _getKeyframeIndex().findPreceding(targetPts);
 
-                    if (_isHardwareAccelerated()) {
-                        if (av_hwframe_transfer_data(swVideoFrame.get(), hwVideoFrame.get(), 0) < 0) {
-                            throw DecoderException("Error transferring frame to system memory");
-                        }
+            const auto keyframePts = keyframe ? keyframe->timestamp : AV_NOPTS_VALUE;
 
-                        if (swVideoFrame->format == AV_PIX_FMT_NONE || !swVideoFrame->data[0]) {
-                            throw DecoderException("Error transferring frame data");
-                        }
+            auto slot = buffer + static_cast<ptrdiff_t>(index) * thumbnailSize;
 
-                        swVideoFrame->best_effort_timestamp = hwVideoFrame->best_effort_timestamp;
+            const auto isCovered = keyFramesOnly
+                                   ? keyframePts != AV_NOPTS_VALUE && keyframePts == lastKeyframePts
+                                   : lastPts != AV_NOPTS_VALUE && lastPts >= targetPts - thresholdPts;
 
-                        swVideoFrame->pts = hwVideoFrame->pts;
+            if (lastIndex && isCovered) {
+                std::memcpy(slot, buffer + static_cast<ptrdiff_t>(*lastIndex) * thumbnailSize, thumbnailSize);
 
-                        av_frame_unref(hwVideoFrame.get());
-                    }
+                thumbnails[index] = thumbnails[*lastIndex];
+
+                continue;
+            }
 
-                    const auto frameTimestampMicros = (swVideoFrame->best_effort_timestamp != AV_NOPTS_VALUE)
-                                                      ? swVideoFrame->best_effort_timestamp : swVideoFrame->pts;
+            const auto isForward = !keyFramesOnly &&
+                                   lastPts != AV_NOPTS_VALUE &&
+                                   keyframePts != AV_NOPTS_VALUE &&
+                                   keyframePts <= lastPts;
 
-                    auto remaining = _processVideo(buffer);
+            if (!isForward) {
+                _seekTo(timestampMicros, keyFramesOnly);
+            }
 
-                    av_frame_unref(swVideoFrame.get());
+            lastPts = AV_NOPTS_VALUE;
 
-                    const auto timestampMicros = av_rescale_q(
-                            frameTimestampMicros,
-                            videoStream->time_base,
-                            AVRational{1, 1'000'000}
-                    );
+            while (_receiveVideoFrame(swVideoFrame.get())) {
+                const auto framePts = (swVideoFrame->best_effort_timestamp != AV_NOPTS_VALUE)
+                                      ? swVideoFrame->best_effort_timestamp : swVideoFrame->pts;
 
-                    return std::optional(
-                            VideoFrame{
-                                    remaining,
-                                    timestampMicros
-                            }
-                    );
+                if (!keyFramesOnly && framePts != AV_NOPTS_VALUE && framePts < targetPts - thresholdPts) {
+                    av_frame_unref(swVideoFrame.get());
+
+                    continue;
                 }
+
+                _processVideo(slot, thumbnailSize);
+
+                av_frame_unref(swVideoFrame.get());
+
+                lastPts = framePts;
+
+                break;
             }
 
-            av_packet_unref(packet.get());
-        }
-    } catch (...) {
-        if (packet) {
-            av_packet_unref(packet.get());
-        }
+            if (lastPts == AV_NOPTS_VALUE) {
+                lastIndex.reset();
 
-        if (hwVideoFrame) {
-            av_frame_unref(hwVideoFrame.get());
-        }
+                continue;
+            }
+
+            lastIndex = index;
 
+            lastKeyframePts = keyframePts;
+
+            thumbnails[index] = VideoFrame{
+                    thumbnailSize,
+                    av_rescale_q(lastPts, videoStream->time_base, AVRational{1, 1'000'000}),
+                    width,
+                    height
+            };
+        }
+    } catch (...) {
         if (swVideoFrame) {
             av_frame_unref(swVideoFrame.get());
         }
 
+        _setOutputSize(previousWidth, previousHeight);
+
+        _startWorker();
+
         throw;
     }
 
-    return std::nullopt;
-}
-
-void Decoder::seekTo(const long timestampMicros, const bool keyFramesOnly) {
-    std::unique_lock<std::shared_mutex> lock(mutex);
+    _setOutputSize(previousWidth, previousHeight);
 
-    if (!_isValid()) {
-        throw DecoderException("Could not use uninitialized decoder");
-    }
+    _startWorker();
 
-    if (timestampMicros < 0 || timestampMicros > format.durationMicros) {
-        throw DecoderException("Timestamp out of bounds");
-    }
+    return thumbnails;
+}
 
+void Decoder::_seekTo(const long timestampMicros, const bool keyFramesOnly) {
     int seekStreamIndex;
 
     AVCodecContext *codecContext = nullptr;
@@ -720,7 +1763,21 @@ void Decoder::seekTo(const long timestampMicros, const bool keyFramesOnly) {
             formatContext->streams[seekStreamIndex]->time_base
     );
 
-    if (av_seek_frame(formatContext.get(), seekStreamIndex, targetPts, AVSEEK_FLAG_BACKWARD) < 0) {
+    std::optional<Keyframe> keyframe;
+
+    if (!keyFramesOnly && videoStream && seekStreamIndex == videoStream->index) {
+        keyframe = _getKeyframeIndex().findPreceding(targetPts);
+    }
+
+    auto isSeeked = false;
+
+    if (keyframe && keyframeIndex->isByteSeekable() && keyframe->position >= 0) {
+        isSeeked = av_seek_frame(formatContext.get(), seekStreamIndex, keyframe->position, AVSEEK_FLAG_BYTE) >= 0;
+    }
+
+    const auto seekPts = keyframe ? keyframe->timestamp : targetPts;
+
+    if (!isSeeked && av_seek_frame(formatContext.get(), seekStreamIndex, seekPts, AVSEEK_FLAG_BACKWARD) < 0) {
         if (av_seek_frame(formatContext.get(), -1, timestampMicros, AVSEEK_FLAG_BACKWARD) < 0) {
             throw DecoderException("Error seeking stream");
         }
@@ -752,6 +1809,10 @@ void Decoder::seekTo(const long timestampMicros, const bool keyFramesOnly) {
 
     audioBuffer.clear();
 
+    _resetAudioConversion();
+
+    _clearPackets();
+
     if (!keyFramesOnly && codecContext) {
         const int64_t thresholdMicros = (videoStream) ? 20'000 : 50'000;
 
@@ -761,22 +1822,18 @@ void Decoder::seekTo(const long timestampMicros, const bool keyFramesOnly) {
                 formatContext->streams[seekStreamIndex]->time_base
         );
 
-        auto tempPacket = std::unique_ptr<AVPacket, AVPacketDeleter>(av_packet_alloc());
+        auto frame = _getPrerollFrame(codecContext);
 
-        if (!tempPacket) {
-            throw DecoderException("Memory allocation failed temporary packet");
-        }
+        const auto skipFrame = codecContext->skip_frame;
 
-        auto tempFrame = std::unique_ptr<AVFrame, AVFrameDeleter>(av_frame_alloc());
+        const auto skipThresholdPts = targetPts - thresholdPts;
 
-        if (!tempFrame) {
-            throw DecoderException("Memory allocation failed temporary frame");
-        }
+        auto restoreDecoding = [&]() {
+            codecContext->skip_frame = skipFrame;
 
-        auto cleanUp = [&]() {
-            tempFrame.reset();
+            av_packet_unref(packet.get());
 
-            tempPacket.reset();
+            av_frame_unref(frame);
         };
 
         try {
@@ -793,37 +1850,70 @@ void Decoder::seekTo(const long timestampMicros, const bool keyFramesOnly) {
             const int MAX_ITERATIONS = std::max(static_cast<long>((fileDurationMs / frameDurationMs) * 2L + 1000),
                                                 1000L);
 
+            const int maxDecodePackets = keyframe
+                                         ? keyframeIndex->getDecodeDistance(*keyframe, targetPts) +
+                                           codecContext->has_b_frames + MAX_SEEK_SLACK_PACKETS
+                                         : MAX_ITERATIONS;
+
             int iterations = 0;
 
-            int64_t lastPts = AV_NOPTS_VALUE;
+            int decodePackets = 0;
+
+            int64_t lastDts = AV_NOPTS_VALUE;
 
-            while (av_read_frame(formatContext.get(), tempPacket.get()) >= 0) {
+            while (av_read_frame(formatContext.get(), packet.get()) >= 0) {
                 if (++iterations > MAX_ITERATIONS) {
+                    _queuePacket(packet.get());
+
                     break;
                 }
 
-                if (tempPacket->stream_index != seekStreamIndex) {
-                    av_packet_unref(tempPacket.get());
+                if (packet->stream_index != seekStreamIndex) {
+                    const auto packetStream = formatContext->streams[packet->stream_index];
+
+                    if (packet->pts != AV_NOPTS_VALUE && av_rescale_q(
+                            packet->pts,
+                            packetStream->time_base,
+                            AVRational{1, AV_TIME_BASE}
+                    ) >= timestampMicros) {
+                        _queuePacket(packet.get());
+                    } else {
+                        av_packet_unref(packet.get());
+                    }
 
                     continue;
                 }
 
-                if (tempPacket->pts != AV_NOPTS_VALUE) {
-                    if (lastPts != AV_NOPTS_VALUE && tempPacket->pts <= lastPts) {
+                if (++decodePackets > maxDecodePackets) {
+                    _queuePacket(packet.get());
+
+                    break;
+                }
+
+                if (packet->dts != AV_NOPTS_VALUE) {
+                    if (lastDts != AV_NOPTS_VALUE && packet->dts < lastDts) {
+                        _queuePacket(packet.get());
+
                         break;
                     }
 
-                    lastPts = tempPacket->pts;
+                    lastDts = packet->dts;
                 }
 
-                if (avcodec_send_packet(codecContext, tempPacket.get()) < 0) {
-                    av_packet_unref(tempPacket.get());
+                const auto isBeforeTarget = packet->pts != AV_NOPTS_VALUE && packet->pts < skipThresholdPts;
+
+                codecContext->skip_frame = isBeforeTarget ? std::max(skipFrame, AVDISCARD_NONREF) : skipFrame;
+
+                if (avcodec_send_packet(codecContext, packet.get()) < 0) {
+                    av_packet_unref(packet.get());
 
                     continue;
                 }
 
+                av_packet_unref(packet.get());
+
                 while (true) {
-                    int ret = avcodec_receive_frame(codecContext, tempFrame.get());
+                    int ret = avcodec_receive_frame(codecContext, frame);
 
                     if (ret == AVERROR(EAGAIN)) {
                         break;
@@ -834,29 +1924,159 @@ void Decoder::seekTo(const long timestampMicros, const bool keyFramesOnly) {
                     }
 
                     if (ret < 0) {
-                        throw DecoderException("Error receiving temporary frame");
+                        throw DecoderException("Error receiving pre-roll frame");
                     }
 
-                    const int64_t framePts = (tempFrame->best_effort_timestamp != AV_NOPTS_VALUE)
-                                             ? tempFrame->best_effort_timestamp : tempFrame->pts;
+                    const int64_t framePts = (frame->best_effort_timestamp != AV_NOPTS_VALUE)
+                                             ? frame->best_effort_timestamp : frame->pts;
 
-                    if (framePts >= targetPts - thresholdPts) {
-                        av_packet_unref(tempPacket.get());
+                    av_frame_unref(frame);
+
+                    if (framePts >= skipThresholdPts) {
+                        restoreDecoding();
 
                         return;
                     }
-
-                    av_frame_unref(tempFrame.get());
                 }
-
-                av_packet_unref(tempPacket.get());
             }
 
-            cleanUp();
+            restoreDecoding();
         } catch (...) {
-            cleanUp();
+            restoreDecoding();
+        }
+    }
+}
+
+AVFrame *Decoder::_getPrerollFrame(const AVCodecContext *codecContext) {
+    if (codecContext == videoCodecContext.get()) {
+        if (hwVideoFrame) {
+            return hwVideoFrame.get();
+        }
+
+        if (swVideoFrame) {
+            return swVideoFrame.get();
+        }
+    } else if (codecContext == audioCodecContext.get() && audioFrame) {
+        return audioFrame.get();
+    }
+
+    if (!prerollFrame) {
+        prerollFrame = std::unique_ptr<AVFrame, AVFrameDeleter>(av_frame_alloc());
+
+        if (!prerollFrame) {
+            throw DecoderException("Memory allocation failed for pre-roll frame");
+        }
+    }
+
+    return prerollFrame.get();
+}
+
+std::vector<Keyframe> Decoder::getKeyframes() {
+    std::shared_ptr<KeyframeIndex> index;
+
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+
+        if (!_isValid()) {
+            throw DecoderException("Could not use uninitialized decoder");
         }
+
+        if (!videoStream) {
+            return {};
+        }
+
+        _getKeyframeIndex();
+
+        index = keyframeIndex;
+    }
+
+    return index->getKeyframes();
+}
+
+Format Decoder::getFormat() {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+
+    return format;
+}
+
+int Decoder::getAudioBufferCapacity() {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+
+    return format.audioBufferCapacity;
+}
+
+void Decoder::setAudioChunkSize(const int samples) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+
+    if (!_isValid()) {
+        throw DecoderException("Could not use uninitialized decoder");
+    }
+
+    if (!_hasAudio() || !swrContext) {
+        throw DecoderException("Could not find audio stream");
+    }
+
+    if (samples < 0) {
+        throw DecoderException("Invalid audio chunk size");
+    }
+
+    if (samples == audioChunkSamples) {
+        return;
+    }
+
+    const auto previousSamples = audioChunkSamples;
+
+    audioChunkSamples = samples;
+
+    try {
+        _updateAudioBufferCapacity();
+    } catch (...) {
+        audioChunkSamples = previousSamples;
+
+        throw;
+    }
+}
+
+void Decoder::setOutputSize(const int width, const int height) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+
+    if (!_isValid()) {
+        throw DecoderException("Could not use uninitialized decoder");
     }
+
+    if (!_hasVideo()) {
+        throw DecoderException("Could not find video stream");
+    }
+
+    if (width < 0 || height < 0 || (width == 0) != (height == 0)) {
+        throw DecoderException("Invalid output size");
+    }
+
+    _setOutputSize(width == 0 ? videoCodecContext->width : width, height == 0 ? videoCodecContext->height : height);
+}
+
+void Decoder::seekTo(const long timestampMicros, const bool keyFramesOnly) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+
+    if (!_isValid()) {
+        throw DecoderException("Could not use uninitialized decoder");
+    }
+
+    if (timestampMicros < 0 || timestampMicros > format.durationMicros) {
+        throw DecoderException("Timestamp out of bounds");
+    }
+
+    _stopWorker();
+
+    try {
+        _seekTo(timestampMicros, keyFramesOnly);
+    } catch (...) {
+        _startWorker();
+
+        throw;
+    }
+
+    _startWorker();
 }
 
 void Decoder::reset() {
@@ -866,7 +2086,11 @@ void Decoder::reset() {
         throw DecoderException("Could not use uninitialized decoder");
     }
 
+    _stopWorker();
+
     if (av_seek_frame(formatContext.get(), -1, 0, AVSEEK_FLAG_BACKWARD) < 0) {
+        _startWorker();
+
         throw DecoderException("Error resetting stream");
     }
 
@@ -891,4 +2115,10 @@ void Decoder::reset() {
     }
 
     audioBuffer.clear();
+
+    _resetAudioConversion();
+
+    _clearPackets();
+
+    _startWorker();
 }
\ No newline at end of file
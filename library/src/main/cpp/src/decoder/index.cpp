@@ -0,0 +1,214 @@
+#include "index.h"
+
+KeyframeIndex::KeyframeIndex(const std::string &location, AVStream *stream, const double frameRate) :
+        timeBase(stream->time_base),
+        frameRate(frameRate) {
+    _buildFromStream(stream);
+
+    if (keyframes.empty()) {
+        isScanned = true;
+
+        isScanComplete = false;
+
+        scanner = std::thread(&KeyframeIndex::_buildFromScan, this, location, stream->index);
+    }
+}
+
+KeyframeIndex::~KeyframeIndex() {
+    isScanCancelled = true;
+
+    if (scanner.joinable()) {
+        scanner.join();
+    }
+}
+
+int KeyframeIndex::_interruptScan(void *opaque) {
+    return static_cast<KeyframeIndex *>(opaque)->isScanCancelled ? 1 : 0;
+}
+
+void KeyframeIndex::_append(const int64_t timestamp, const int64_t position) {
+    if (!keyframes.empty() && timestamp <= keyframes.back().timestamp) {
+        return;
+    }
+
+    keyframes.push_back(
+            Keyframe{
+                    timestamp,
+                    av_rescale_q(timestamp, timeBase, AVRational{1, AV_TIME_BASE}),
+                    position,
+                    0
+            }
+    );
+}
+
+void KeyframeIndex::_estimateGopFrames(const int64_t endTimestamp) {
+    if (frameRate <= 0) {
+        return;
+    }
+
+    for (size_t i = 0; i < keyframes.size(); ++i) {
+        auto &keyframe = keyframes[i];
+
+        const auto nextTimestamp = i + 1 < keyframes.size() ? keyframes[i + 1].timestamp : endTimestamp;
+
+        if (nextTimestamp == AV_NOPTS_VALUE || nextTimestamp <= keyframe.timestamp) {
+            continue;
+        }
+
+        const auto seconds = static_cast<double>(nextTimestamp - keyframe.timestamp) * av_q2d(timeBase);
+
+        keyframe.gopFrames = std::max(1, static_cast<int>(seconds * frameRate + 0.5));
+    }
+}
+
+void KeyframeIndex::_buildFromStream(AVStream *stream) {
+    const auto count = avformat_index_get_entries_count(stream);
+
+    bool hasDeltaFrames = false;
+
+    for (int i = 0; i < count; ++i) {
+        const auto entry = avformat_index_get_entry(stream, i);
+
+        if (!entry) {
+            continue;
+        }
+
+        if (entry->flags & AVINDEX_KEYFRAME) {
+            _append(entry->timestamp, entry->pos);
+        } else {
+            hasDeltaFrames = true;
+
+            if (!keyframes.empty()) {
+                ++keyframes.back().gopFrames;
+            }
+        }
+    }
+
+    if (hasDeltaFrames) {
+        for (auto &keyframe: keyframes) {
+            ++keyframe.gopFrames;
+        }
+    } else {
+        const auto endTimestamp = stream->duration == AV_NOPTS_VALUE || stream->start_time == AV_NOPTS_VALUE
+                                  ? AV_NOPTS_VALUE
+                                  : stream->start_time + stream->duration;
+
+        _estimateGopFrames(endTimestamp);
+    }
+}
+
+void KeyframeIndex::_buildFromScan(const std::string &location, const int streamIndex) {
+    auto rawFormatContext = avformat_alloc_context();
+
+    if (!rawFormatContext) {
+        _completeScan();
+
+        return;
+    }
+
+    rawFormatContext->interrupt_callback.callback = &KeyframeIndex::_interruptScan;
+
+    rawFormatContext->interrupt_callback.opaque = this;
+
+    if (avformat_open_input(&rawFormatContext, location.c_str(), nullptr, nullptr) < 0 || !rawFormatContext) {
+        _completeScan();
+
+        return;
+    }
+
+    auto scanContext = std::unique_ptr<AVFormatContext, AVFormatContextDeleter>(rawFormatContext);
+
+    auto scanPacket = std::unique_ptr<AVPacket, AVPacketDeleter>(av_packet_alloc());
+
+    if (!scanPacket ||
+        avformat_find_stream_info(scanContext.get(), nullptr) < 0 ||
+        streamIndex < 0 ||
+        streamIndex >= static_cast<int>(scanContext->nb_streams)) {
+        _completeScan();
+
+        return;
+    }
+
+    for (unsigned int i = 0; i < scanContext->nb_streams; ++i) {
+        if (static_cast<int>(i) != streamIndex) {
+            scanContext->streams[i]->discard = AVDISCARD_ALL;
+        }
+    }
+
+    while (!isScanCancelled && av_read_frame(scanContext.get(), scanPacket.get()) >= 0) {
+        if (scanPacket->stream_index == streamIndex) {
+            const auto timestamp = scanPacket->pts != AV_NOPTS_VALUE ? scanPacket->pts : scanPacket->dts;
+
+            std::unique_lock<std::mutex> lock(scanMutex);
+
+            if ((scanPacket->flags & AV_PKT_FLAG_KEY) && timestamp != AV_NOPTS_VALUE) {
+                _append(timestamp, scanPacket->pos);
+            }
+
+            if (!keyframes.empty()) {
+                ++keyframes.back().gopFrames;
+            }
+        }
+
+        av_packet_unref(scanPacket.get());
+    }
+
+    _completeScan();
+}
+
+void KeyframeIndex::_completeScan() {
+    {
+        std::unique_lock<std::mutex> lock(scanMutex);
+
+        isScanComplete = true;
+    }
+
+    scanCondition.notify_all();
+}
+
+bool KeyframeIndex::isByteSeekable() const {
+    return isScanned;
+}
+
+std::vector<Keyframe> KeyframeIndex::getKeyframes() {
+    std::unique_lock<std::mutex> lock(scanMutex);
+
+    scanCondition.wait(lock, [this] { return isScanComplete; });
+
+    return keyframes;
+}
+
+std::optional<Keyframe> KeyframeIndex::findPreceding(const int64_t timestamp) const {
+    std::unique_lock<std::mutex> lock(scanMutex);
+
+    if (!isScanComplete && (keyframes.empty() || keyframes.back().timestamp <= timestamp)) {
+        return std::nullopt;
+    }
+
+    auto it = std::upper_bound(
+            keyframes.begin(),
+            keyframes.end(),
+            timestamp,
+            [](const int64_t value, const Keyframe &keyframe) {
+                return value < keyframe.timestamp;
+            }
+    );
+
+    if (it == keyframes.begin()) {
+        return std::nullopt;
+    }
+
+    return *std::prev(it);
+}
+
+int KeyframeIndex::getDecodeDistance(const Keyframe &keyframe, const int64_t timestamp) const {
+    if (frameRate <= 0 || timestamp <= keyframe.timestamp) {
+        return 0;
+    }
+
+    const auto seconds = static_cast<double>(timestamp - keyframe.timestamp) * av_q2d(timeBase);
+
+    const auto distance = static_cast<int>(seconds * frameRate + 0.5);
+
+    return keyframe.gopFrames > 0 ? std::min(distance, keyframe.gopFrames) : distance;
+}
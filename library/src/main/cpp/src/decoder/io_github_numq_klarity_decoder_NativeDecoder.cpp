@@ -30,7 +30,15 @@ JNIEXPORT jlong JNICALL Java_io_github_numq_klarity_decoder_NativeDecoder_00024N
         jboolean findVideoStream,
         jboolean decodeAudioStream,
         jboolean decodeVideoStream,
-        jintArray hardwareAccelerationCandidates
+        jintArray hardwareAccelerationCandidates,
+        jint readAheadFrames,
+        jint videoOutputFormat,
+        jint threadCount,
+        jint threadType,
+        jint decodingProfile,
+        jint sampleRate,
+        jint channels,
+        jint audioOutputFormat
 ) {
     return handleException<jlong>(env, [&] {
         auto locationChars = env->GetStringUTFChars(location, nullptr);
@@ -64,7 +72,15 @@ JNIEXPORT jlong JNICALL Java_io_github_numq_klarity_decoder_NativeDecoder_00024N
                 findVideoStream,
                 decodeAudioStream,
                 decodeVideoStream,
-                candidates
+                candidates,
+                static_cast<int>(readAheadFrames),
+                static_cast<VideoOutputFormat>(videoOutputFormat),
+                static_cast<int>(threadCount),
+                static_cast<ThreadType>(threadType),
+                static_cast<DecodingProfile>(decodingProfile),
+                static_cast<int>(sampleRate),
+                static_cast<int>(channels),
+                static_cast<AudioOutputFormat>(audioOutputFormat)
         );
 
         return reinterpret_cast<jlong>(decoder);
@@ -79,7 +95,7 @@ JNIEXPORT jobject JNICALL Java_io_github_numq_klarity_decoder_NativeDecoder_0002
     return handleException<jobject>(env, [&] {
         auto decoder = getDecoderPointer(decoderHandle);
 
-        auto format = decoder->format;
+        auto format = decoder->getFormat();
 
         auto location = env->NewStringUTF(format.location.c_str());
 
@@ -87,6 +103,16 @@ JNIEXPORT jobject JNICALL Java_io_github_numq_klarity_decoder_NativeDecoder_0002
             throw std::runtime_error("Could not create location string");
         }
 
+        auto videoStrides = env->NewIntArray(4);
+
+        if (!videoStrides) {
+            env->DeleteLocalRef(location);
+
+            throw std::runtime_error("Could not create video strides array");
+        }
+
+        env->SetIntArrayRegion(videoStrides, 0, 4, reinterpret_cast<const jint *>(format.videoStrides));
+
         auto formatObject = env->NewObject(
                 formatClass,
                 formatConstructor,
@@ -94,13 +120,19 @@ JNIEXPORT jobject JNICALL Java_io_github_numq_klarity_decoder_NativeDecoder_0002
                 static_cast<jlong>(format.durationMicros),
                 static_cast<jint>(format.sampleRate),
                 static_cast<jint>(format.channels),
+                static_cast<jint>(format.audioBufferCapacity),
+                static_cast<jint>(format.audioSampleFormat),
                 static_cast<jint>(format.width),
                 static_cast<jint>(format.height),
                 static_cast<jdouble>(format.frameRate),
                 static_cast<jint>(format.hwDeviceType),
-                static_cast<jint>(format.videoBufferCapacity)
+                static_cast<jint>(format.videoBufferCapacity),
+                static_cast<jint>(format.videoPixelFormat),
+                videoStrides
         );
 
+        env->DeleteLocalRef(videoStrides);
+
         env->DeleteLocalRef(location);
 
         return formatObject;
@@ -138,6 +170,31 @@ JNIEXPORT jobject JNICALL Java_io_github_numq_klarity_decoder_NativeDecoder_0002
     }, nullptr);
 }
 
+JNIEXPORT jobject JNICALL Java_io_github_numq_klarity_decoder_NativeDecoder_00024Native_decodeAudioInto(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong decoderHandle,
+        jlong buffer,
+        jint capacity
+) {
+    return handleException<jobject>(env, [&] {
+        auto decoder = getDecoderPointer(decoderHandle);
+
+        auto chunk = decoder->decodeAudio(reinterpret_cast<uint8_t *>(buffer), capacity);
+
+        if (!chunk.has_value()) {
+            return static_cast<jobject>(nullptr);
+        }
+
+        return env->NewObject(
+                audioChunkClass,
+                audioChunkConstructor,
+                static_cast<jint>(chunk->remaining),
+                static_cast<jlong>(chunk->timestampMicros)
+        );
+    }, nullptr);
+}
+
 JNIEXPORT jobject JNICALL Java_io_github_numq_klarity_decoder_NativeDecoder_00024Native_decodeVideo(
         JNIEnv *env,
         jclass thisClass,
@@ -158,11 +215,134 @@ JNIEXPORT jobject JNICALL Java_io_github_numq_klarity_decoder_NativeDecoder_0002
                 videoFrameClass,
                 videoFrameConstructor,
                 static_cast<jint>(frame->remaining),
-                static_cast<jlong>(frame->timestampMicros)
+                static_cast<jlong>(frame->timestampMicros),
+                static_cast<jint>(frame->width),
+                static_cast<jint>(frame->height)
         );
     }, nullptr);
 }
 
+JNIEXPORT jobjectArray JNICALL Java_io_github_numq_klarity_decoder_NativeDecoder_00024Native_decodeThumbnails(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong decoderHandle,
+        jlongArray timestampsMicros,
+        jint width,
+        jint height,
+        jboolean keyFramesOnly,
+        jlong buffer,
+        jint capacity
+) {
+    return handleException<jobjectArray>(env, [&] {
+        auto decoder = getDecoderPointer(decoderHandle);
+
+        auto timestampsSize = env->GetArrayLength(timestampsMicros);
+
+        std::vector<int64_t> timestamps(timestampsSize);
+
+        if (timestampsSize > 0) {
+            env->GetLongArrayRegion(timestampsMicros, 0, timestampsSize, reinterpret_cast<jlong *>(timestamps.data()));
+        }
+
+        auto thumbnails = decoder->decodeThumbnails(
+                timestamps,
+                static_cast<int>(width),
+                static_cast<int>(height),
+                keyFramesOnly,
+                reinterpret_cast<uint8_t *>(buffer),
+                capacity
+        );
+
+        auto result = env->NewObjectArray(static_cast<jsize>(thumbnails.size()), videoFrameClass, nullptr);
+
+        if (!result) {
+            return static_cast<jobjectArray>(nullptr);
+        }
+
+        for (size_t i = 0; i < thumbnails.size(); ++i) {
+            if (!thumbnails[i].has_value()) {
+                continue;
+            }
+
+            auto frame = env->NewObject(
+                    videoFrameClass,
+                    videoFrameConstructor,
+                    static_cast<jint>(thumbnails[i]->remaining),
+                    static_cast<jlong>(thumbnails[i]->timestampMicros),
+                    static_cast<jint>(thumbnails[i]->width),
+                    static_cast<jint>(thumbnails[i]->height)
+            );
+
+            env->SetObjectArrayElement(result, static_cast<jsize>(i), frame);
+
+            env->DeleteLocalRef(frame);
+        }
+
+        return result;
+    }, nullptr);
+}
+
+JNIEXPORT jlongArray JNICALL Java_io_github_numq_klarity_decoder_NativeDecoder_00024Native_getKeyframes(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong decoderHandle
+) {
+    return handleException<jlongArray>(env, [&] {
+        auto decoder = getDecoderPointer(decoderHandle);
+
+        auto keyframes = decoder->getKeyframes();
+
+        std::vector<jlong> values;
+
+        values.reserve(keyframes.size() * 2);
+
+        for (const auto &keyframe: keyframes) {
+            values.push_back(static_cast<jlong>(keyframe.timestampMicros));
+
+            values.push_back(static_cast<jlong>(keyframe.gopFrames));
+        }
+
+        auto size = static_cast<jsize>(values.size());
+
+        auto result = env->NewLongArray(size);
+
+        if (result) {
+            env->SetLongArrayRegion(result, 0, size, values.data());
+
+            return result;
+        }
+
+        return static_cast<jlongArray>(nullptr);
+    }, nullptr);
+}
+
+JNIEXPORT void JNICALL Java_io_github_numq_klarity_decoder_NativeDecoder_00024Native_setAudioChunkSize(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong decoderHandle,
+        jint samples
+) {
+    return handleException(env, [&] {
+        auto decoder = getDecoderPointer(decoderHandle);
+
+        decoder->setAudioChunkSize(static_cast<int>(samples));
+    });
+}
+
+JNIEXPORT void JNICALL Java_io_github_numq_klarity_decoder_NativeDecoder_00024Native_setOutputSize(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong decoderHandle,
+        jint width,
+        jint height
+) {
+    return handleException(env, [&] {
+        auto decoder = getDecoderPointer(decoderHandle);
+
+        decoder->setOutputSize(static_cast<int>(width), static_cast<int>(height));
+    });
+}
+
 JNIEXPORT void JNICALL Java_io_github_numq_klarity_decoder_NativeDecoder_00024Native_seekTo(
         JNIEnv *env,
         jclass thisClass,
@@ -0,0 +1,69 @@
+#include "ring.h"
+
+FrameRing::FrameRing(const size_t capacity) {
+    if (capacity == 0) {
+        throw DecoderException("Invalid frame ring capacity");
+    }
+
+    frames.reserve(capacity);
+
+    for (size_t i = 0; i < capacity; ++i) {
+        auto frame = std::unique_ptr<AVFrame, AVFrameDeleter>(av_frame_alloc());
+
+        if (!frame) {
+            throw DecoderException("Memory allocation failed for frame ring");
+        }
+
+        frames.push_back(std::move(frame));
+    }
+}
+
+bool FrameRing::isEmpty() const {
+    return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+}
+
+bool FrameRing::isFull() const {
+    return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire) == frames.size();
+}
+
+AVFrame *FrameRing::acquire() {
+    const auto currentTail = tail.load(std::memory_order_relaxed);
+
+    if (currentTail - head.load(std::memory_order_acquire) == frames.size()) {
+        return nullptr;
+    }
+
+    return frames[currentTail % frames.size()].get();
+}
+
+void FrameRing::publish() {
+    tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+AVFrame *FrameRing::peek() {
+    const auto currentHead = head.load(std::memory_order_relaxed);
+
+    if (currentHead == tail.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+
+    return frames[currentHead % frames.size()].get();
+}
+
+void FrameRing::release() {
+    const auto currentHead = head.load(std::memory_order_relaxed);
+
+    av_frame_unref(frames[currentHead % frames.size()].get());
+
+    head.store(currentHead + 1, std::memory_order_release);
+}
+
+void FrameRing::clear() {
+    for (auto &frame: frames) {
+        av_frame_unref(frame.get());
+    }
+
+    head.store(0, std::memory_order_release);
+
+    tail.store(0, std::memory_order_release);
+}
@@ -0,0 +1,177 @@
+#include "workers.h"
+
+WorkerPool::WorkerPool(const size_t threadCount) {
+    threads.reserve(threadCount);
+
+    for (size_t i = 0; i < threadCount; ++i) {
+        threads.emplace_back(&WorkerPool::_work, this);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        isStopRequested = true;
+    }
+
+    condition.notify_all();
+
+    for (auto &thread: threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+WorkerPool &WorkerPool::getShared() {
+    static WorkerPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+
+    return pool;
+}
+
+int WorkerPool::getConcurrency() const {
+    return static_cast<int>(threads.size()) + 1;
+}
+
+void WorkerPool::_drain(Batch &batch) {
+    int index;
+
+    while ((index = batch.next.fetch_add(1, std::memory_order_relaxed)) < batch.count) {
+        try {
+            batch.invoke(batch.context, index);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(batch.mutex);
+
+            if (!batch.exception) {
+                batch.exception = std::current_exception();
+            }
+        }
+
+        if (batch.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(batch.mutex);
+
+            batch.completion.notify_all();
+        }
+    }
+}
+
+WorkerPool::Batch *WorkerPool::_findBatch() {
+    for (auto batch: batches) {
+        if (batch->next.load(std::memory_order_relaxed) < batch->count &&
+            batch->helpers.load(std::memory_order_relaxed) < batch->count - 1) {
+            return batch;
+        }
+    }
+
+    return nullptr;
+}
+
+void WorkerPool::_work() {
+    while (true) {
+        Batch *batch = nullptr;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+
+            condition.wait(lock, [this, &batch] { return isStopRequested || (batch = _findBatch()); });
+
+            if (isStopRequested) {
+                return;
+            }
+
+            batch->helpers.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        _drain(*batch);
+
+        if (batch->helpers.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(batch->mutex);
+
+            batch->completion.notify_all();
+        }
+    }
+}
+
+void WorkerPool::_run(const int count, void *context, const Invoke invoke) {
+    if (count <= 0) {
+        return;
+    }
+
+    if (count == 1 || threads.empty()) {
+        for (int index = 0; index < count; ++index) {
+            invoke(context, index);
+        }
+
+        return;
+    }
+
+    std::unique_ptr<Batch> batch;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (!spareBatches.empty()) {
+            batch = std::move(spareBatches.back());
+
+            spareBatches.pop_back();
+        }
+    }
+
+    if (!batch) {
+        batch = std::make_unique<Batch>();
+    }
+
+    batch->context = context;
+
+    batch->invoke = invoke;
+
+    batch->count = count;
+
+    batch->exception = nullptr;
+
+    batch->remaining.store(count, std::memory_order_relaxed);
+
+    batch->next.store(0, std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        batches.push_back(batch.get());
+    }
+
+    condition.notify_all();
+
+    _drain(*batch);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        batches.erase(std::find(batches.begin(), batches.end(), batch.get()));
+    }
+
+    std::exception_ptr exception;
+
+    {
+        std::unique_lock<std::mutex> lock(batch->mutex);
+
+        batch->completion.wait(lock, [&batch] {
+            return batch->remaining.load(std::memory_order_acquire) == 0 &&
+                   batch->helpers.load(std::memory_order_acquire) == 0;
+        });
+
+        exception = std::move(batch->exception);
+
+        batch->exception = nullptr;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        spareBatches.push_back(std::move(batch));
+    }
+
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
@@ -0,0 +1,114 @@
+#include "io_github_numq_klarity_pipeline_NativeAudioPipeline.h"
+
+JNIEXPORT jlong JNICALL Java_io_github_numq_klarity_pipeline_NativeAudioPipeline_00024Native_create(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong decoderHandle,
+        jlong samplerHandle
+) {
+    return handleException<jlong>(env, [&] {
+        auto pipeline = new AudioPipeline(
+                getDecoderPointer(decoderHandle),
+                getSamplerPointer(samplerHandle)
+        );
+
+        return reinterpret_cast<jlong>(pipeline);
+    }, -1);
+}
+
+JNIEXPORT void JNICALL Java_io_github_numq_klarity_pipeline_NativeAudioPipeline_00024Native_start(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong pipelineHandle
+) {
+    return handleException(env, [&] {
+        auto pipeline = getAudioPipelinePointer(pipelineHandle);
+
+        pipeline->start();
+    });
+}
+
+JNIEXPORT void JNICALL Java_io_github_numq_klarity_pipeline_NativeAudioPipeline_00024Native_stop(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong pipelineHandle
+) {
+    return handleException(env, [&] {
+        auto pipeline = getAudioPipelinePointer(pipelineHandle);
+
+        pipeline->stop();
+    });
+}
+
+JNIEXPORT void JNICALL Java_io_github_numq_klarity_pipeline_NativeAudioPipeline_00024Native_seekTo(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong pipelineHandle,
+        jlong timestampMicros
+) {
+    return handleException(env, [&] {
+        auto pipeline = getAudioPipelinePointer(pipelineHandle);
+
+        pipeline->seekTo(static_cast<long>(timestampMicros));
+    });
+}
+
+JNIEXPORT void JNICALL Java_io_github_numq_klarity_pipeline_NativeAudioPipeline_00024Native_setVolume(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong pipelineHandle,
+        jfloat volume
+) {
+    return handleException(env, [&] {
+        auto pipeline = getAudioPipelinePointer(pipelineHandle);
+
+        pipeline->setVolume(volume);
+    });
+}
+
+JNIEXPORT void JNICALL Java_io_github_numq_klarity_pipeline_NativeAudioPipeline_00024Native_setPlaybackSpeed(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong pipelineHandle,
+        jfloat factor
+) {
+    return handleException(env, [&] {
+        auto pipeline = getAudioPipelinePointer(pipelineHandle);
+
+        pipeline->setPlaybackSpeed(factor);
+    });
+}
+
+JNIEXPORT jlong JNICALL Java_io_github_numq_klarity_pipeline_NativeAudioPipeline_00024Native_getTimestampMicros(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong pipelineHandle
+) {
+    return handleException<jlong>(env, [&] {
+        auto pipeline = getAudioPipelinePointer(pipelineHandle);
+
+        return static_cast<jlong>(pipeline->getTimestampMicros());
+    }, 0);
+}
+
+JNIEXPORT jboolean JNICALL Java_io_github_numq_klarity_pipeline_NativeAudioPipeline_00024Native_isCompleted(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong pipelineHandle
+) {
+    return handleException<jboolean>(env, [&] {
+        auto pipeline = getAudioPipelinePointer(pipelineHandle);
+
+        return static_cast<jboolean>(pipeline->isCompleted());
+    }, JNI_FALSE);
+}
+
+JNIEXPORT void JNICALL Java_io_github_numq_klarity_pipeline_NativeAudioPipeline_00024Native_delete(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong pipelineHandle
+) {
+    return handleException(env, [&] {
+        delete getAudioPipelinePointer(pipelineHandle);
+    });
+}
\ No newline at end of file
@@ -0,0 +1,253 @@
+#include "pipeline.h"
+
+AudioPipeline::AudioPipeline(Decoder *decoder, Sampler *sampler) : decoder(decoder), sampler(sampler) {
+    if (!decoder || !sampler) {
+        throw PipelineException("Unable to create pipeline without decoder and sampler");
+    }
+
+    const auto format = decoder->getFormat();
+
+    if (format.sampleRate <= 0 || format.channels <= 0 || format.audioBufferCapacity <= 0) {
+        throw PipelineException("Unable to create pipeline without audio stream");
+    }
+
+    switch (format.audioSampleFormat) {
+        case AV_SAMPLE_FMT_FLT:
+            isPlanar = false;
+
+            break;
+
+        case AV_SAMPLE_FMT_FLTP:
+            isPlanar = true;
+
+            break;
+
+        default:
+            throw PipelineException("Unsupported audio sample format");
+    }
+
+    sampleRate = format.sampleRate;
+
+    durationMicros = format.durationMicros;
+
+    bytesPerFrame = static_cast<int>(sizeof(float)) * format.channels;
+
+    buffer.resize(format.audioBufferCapacity);
+
+    worker = std::thread(&AudioPipeline::_runWorker, this);
+}
+
+AudioPipeline::~AudioPipeline() {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        isStopRequested = true;
+
+        isPlaying = false;
+    }
+
+    condition.notify_all();
+
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void AudioPipeline::_runWorker() {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (true) {
+        isBusy = false;
+
+        condition.notify_all();
+
+        condition.wait(lock, [this] { return isStopRequested || isPlaying; });
+
+        if (isStopRequested) {
+            return;
+        }
+
+        isBusy = true;
+
+        lock.unlock();
+
+        try {
+            _pump();
+        } catch (...) {
+            lock.lock();
+
+            workerException = std::current_exception();
+
+            isPlaying = false;
+
+            continue;
+        }
+
+        lock.lock();
+    }
+}
+
+void AudioPipeline::_pump() {
+    const auto audioBufferCapacity = decoder->getAudioBufferCapacity();
+
+    if (static_cast<int>(buffer.size()) < audioBufferCapacity) {
+        buffer.resize(audioBufferCapacity);
+    }
+
+    auto currentVolume = volume.load();
+
+    auto currentPlaybackSpeedFactor = playbackSpeedFactor.load();
+
+    auto chunk = decoder->decodeAudio(buffer.data(), static_cast<int>(buffer.size()));
+
+    if (!chunk) {
+        sampler->drain(currentVolume, currentPlaybackSpeedFactor);
+
+        _resetClock(durationMicros);
+
+        isEndOfStream = true;
+
+        std::unique_lock<std::mutex> lock(mutex);
+
+        isPlaying = false;
+
+        return;
+    }
+
+    if (chunk->remaining <= 0) {
+        return;
+    }
+
+    if (isPlanar) {
+        sampler->writePlanar(buffer.data(), chunk->remaining, currentVolume, currentPlaybackSpeedFactor);
+    } else {
+        sampler->write(buffer.data(), chunk->remaining, currentVolume, currentPlaybackSpeedFactor);
+    }
+
+    auto samples = static_cast<int64_t>(chunk->remaining / bytesPerFrame);
+
+    auto latencyMicros = sampler->getLatency(false);
+
+    std::unique_lock<std::mutex> lock(clockMutex);
+
+    clockMicros = chunk->timestampMicros + samples * 1'000'000 / sampleRate;
+
+    clockFrames = sampler->getWrittenFrames();
+
+    clockLatencyMicros = latencyMicros;
+
+    clockPlaybackSpeedFactor = currentPlaybackSpeedFactor;
+
+    isClockAnchored = true;
+}
+
+void AudioPipeline::_resetClock(const int64_t timestampMicros) {
+    std::unique_lock<std::mutex> lock(clockMutex);
+
+    clockMicros = timestampMicros;
+
+    clockFrames = 0;
+
+    isClockAnchored = false;
+}
+
+void AudioPipeline::_pause(std::unique_lock<std::mutex> &lock) {
+    isPlaying = false;
+
+    condition.wait(lock, [this] { return !isBusy; });
+}
+
+void AudioPipeline::_rethrowWorkerException() {
+    if (workerException) {
+        auto exception = workerException;
+
+        workerException = nullptr;
+
+        std::rethrow_exception(exception);
+    }
+}
+
+void AudioPipeline::start() {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    _rethrowWorkerException();
+
+    if (isPlaying) {
+        return;
+    }
+
+    if (isEndOfStream) {
+        throw PipelineException("Unable to start completed pipeline");
+    }
+
+    sampler->start();
+
+    isPlaying = true;
+
+    condition.notify_all();
+}
+
+void AudioPipeline::stop() {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    _pause(lock);
+
+    sampler->stop();
+
+    _rethrowWorkerException();
+}
+
+void AudioPipeline::seekTo(const long timestampMicros) {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    _pause(lock);
+
+    sampler->flush();
+
+    decoder->seekTo(timestampMicros, false);
+
+    _resetClock(timestampMicros);
+
+    isEndOfStream = false;
+
+    workerException = nullptr;
+}
+
+void AudioPipeline::setVolume(const float value) {
+    if (value < 0.0f || value > 1.0f) {
+        throw PipelineException("Volume must be between 0.0 and 1.0");
+    }
+
+    volume = value;
+}
+
+void AudioPipeline::setPlaybackSpeed(const float factor) {
+    if (factor < 0.5f || factor > 2.0f) {
+        throw PipelineException("Playback speed factor must be between 0.5 and 2.0");
+    }
+
+    playbackSpeedFactor = factor;
+}
+
+int64_t AudioPipeline::getTimestampMicros() const {
+    std::unique_lock<std::mutex> lock(clockMutex);
+
+    if (!isClockAnchored) {
+        return clockMicros;
+    }
+
+    const auto playedFrames = sampler->getPlayedFrames();
+
+    const auto pendingFrames = clockFrames > playedFrames ? static_cast<int64_t>(clockFrames - playedFrames) : 0;
+
+    const auto pendingMicros = pendingFrames * 1'000'000 / sampleRate + clockLatencyMicros;
+
+    return std::max<int64_t>(
+            0,
+            clockMicros - static_cast<int64_t>(static_cast<float>(pendingMicros) * clockPlaybackSpeedFactor)
+    );
+}
+
+bool AudioPipeline::isCompleted() const {
+    return isEndOfStream.load();
+}
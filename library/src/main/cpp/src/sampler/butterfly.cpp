@@ -0,0 +1,422 @@
+#include "butterfly.h"
+
+extern "C" {
+#include <libavutil/cpu.h>
+}
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define KLARITY_BUTTERFLY_X86
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define KLARITY_BUTTERFLY_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define KLARITY_TARGET(name) __attribute__((target(name)))
+#else
+#define KLARITY_TARGET(name)
+#endif
+
+namespace {
+    using complex = std::complex<float>;
+
+    template<bool conjugateSecond>
+    inline complex complexMul(const complex &a, const complex &b) {
+        const float aReal = a.real(), aImag = a.imag();
+
+        const float bReal = b.real(), bImag = b.imag();
+
+        return conjugateSecond ? complex{
+                bReal * aReal + bImag * aImag,
+                bReal * aImag - bImag * aReal
+        } : complex{
+                aReal * bReal - aImag * bImag,
+                aReal * bImag + aImag * bReal
+        };
+    }
+
+    template<bool flipped>
+    inline complex complexAddI(const complex &a, const complex &b) {
+        const float aReal = a.real(), aImag = a.imag();
+
+        const float bReal = b.real(), bImag = b.imag();
+
+        return flipped ? complex{aReal + bImag, aImag - bReal} : complex{aReal - bImag, aImag + bReal};
+    }
+
+    template<bool inverse>
+    inline void radix2Scalar(complex *data, const complex *twiddles, const size_t stride, size_t j) {
+        for (; j < stride; ++j) {
+            const complex a = data[j];
+
+            const complex b = complexMul<inverse>(data[j + stride], twiddles[j * 2 + 1]);
+
+            data[j] = a + b;
+
+            data[j + stride] = a - b;
+        }
+    }
+
+    template<bool inverse>
+    inline void radix4Scalar(complex *data, const complex *twiddles, const size_t stride, size_t j) {
+        for (; j < stride; ++j) {
+            const complex a = data[j];
+
+            const complex c = complexMul<inverse>(data[j + stride], twiddles[j * 4 + 2]);
+
+            const complex b = complexMul<inverse>(data[j + stride * 2], twiddles[j * 4 + 1]);
+
+            const complex d = complexMul<inverse>(data[j + stride * 3], twiddles[j * 4 + 3]);
+
+            const complex sumAC = a + c, sumBD = b + d;
+
+            const complex diffAC = a - c, diffBD = b - d;
+
+            data[j] = sumAC + sumBD;
+
+            data[j + stride] = complexAddI<!inverse>(diffAC, diffBD);
+
+            data[j + stride * 2] = sumAC - sumBD;
+
+            data[j + stride * 3] = complexAddI<inverse>(diffAC, diffBD);
+        }
+    }
+
+    template<bool inverse>
+    void radix2Fallback(complex *data, const complex *twiddles, const size_t stride, const size_t outerRepeats) {
+        for (size_t outer = 0; outer < outerRepeats; ++outer, data += stride * 2) {
+            radix2Scalar<inverse>(data, twiddles, stride, 0);
+        }
+    }
+
+    template<bool inverse>
+    void radix4Fallback(complex *data, const complex *twiddles, const size_t stride, const size_t outerRepeats) {
+        for (size_t outer = 0; outer < outerRepeats; ++outer, data += stride * 4) {
+            radix4Scalar<inverse>(data, twiddles, stride, 0);
+        }
+    }
+
+#if defined(KLARITY_BUTTERFLY_X86)
+
+    inline float *floats(complex *data) {
+        return reinterpret_cast<float *>(data);
+    }
+
+    KLARITY_TARGET("sse3")
+    inline __m128 loadTwiddlesSse3(const complex *twiddles, const size_t j, const size_t factor, const size_t index) {
+        const auto low = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double *>(twiddles + j * factor + index)));
+
+        return _mm_castpd_ps(_mm_loadh_pd(
+                _mm_castps_pd(low),
+                reinterpret_cast<const double *>(twiddles + (j + 1) * factor + index)
+        ));
+    }
+
+    template<bool inverse>
+    KLARITY_TARGET("sse3")
+    inline __m128 mulSse3(const __m128 a, __m128 b) {
+        if (inverse) {
+            b = _mm_xor_ps(b, _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f));
+        }
+
+        const auto swapped = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1));
+
+        return _mm_addsub_ps(_mm_mul_ps(a, _mm_moveldup_ps(b)), _mm_mul_ps(swapped, _mm_movehdup_ps(b)));
+    }
+
+    template<bool flipped>
+    KLARITY_TARGET("sse3")
+    inline __m128 addISse3(const __m128 a, const __m128 b) {
+        const auto swapped = _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1));
+
+        return flipped ? _mm_addsub_ps(a, _mm_xor_ps(swapped, _mm_set1_ps(-0.0f))) : _mm_addsub_ps(a, swapped);
+    }
+
+    template<bool inverse>
+    KLARITY_TARGET("sse3")
+    void radix2Sse3(complex *data, const complex *twiddles, const size_t stride, const size_t outerRepeats) {
+        for (size_t outer = 0; outer < outerRepeats; ++outer, data += stride * 2) {
+            size_t j = 0;
+
+            for (; j + 2 <= stride; j += 2) {
+                const auto a = _mm_loadu_ps(floats(data + j));
+
+                const auto b = mulSse3<inverse>(_mm_loadu_ps(floats(data + j + stride)), loadTwiddlesSse3(twiddles, j, 2, 1));
+
+                _mm_storeu_ps(floats(data + j), _mm_add_ps(a, b));
+
+                _mm_storeu_ps(floats(data + j + stride), _mm_sub_ps(a, b));
+            }
+
+            radix2Scalar<inverse>(data, twiddles, stride, j);
+        }
+    }
+
+    template<bool inverse>
+    KLARITY_TARGET("sse3")
+    void radix4Sse3(complex *data, const complex *twiddles, const size_t stride, const size_t outerRepeats) {
+        for (size_t outer = 0; outer < outerRepeats; ++outer, data += stride * 4) {
+            size_t j = 0;
+
+            for (; j + 2 <= stride; j += 2) {
+                const auto a = _mm_loadu_ps(floats(data + j));
+
+                const auto c = mulSse3<inverse>(_mm_loadu_ps(floats(data + j + stride)), loadTwiddlesSse3(twiddles, j, 4, 2));
+
+                const auto b = mulSse3<inverse>(_mm_loadu_ps(floats(data + j + stride * 2)), loadTwiddlesSse3(twiddles, j, 4, 1));
+
+                const auto d = mulSse3<inverse>(_mm_loadu_ps(floats(data + j + stride * 3)), loadTwiddlesSse3(twiddles, j, 4, 3));
+
+                const auto sumAC = _mm_add_ps(a, c), sumBD = _mm_add_ps(b, d);
+
+                const auto diffAC = _mm_sub_ps(a, c), diffBD = _mm_sub_ps(b, d);
+
+                _mm_storeu_ps(floats(data + j), _mm_add_ps(sumAC, sumBD));
+
+                _mm_storeu_ps(floats(data + j + stride), addISse3<!inverse>(diffAC, diffBD));
+
+                _mm_storeu_ps(floats(data + j + stride * 2), _mm_sub_ps(sumAC, sumBD));
+
+                _mm_storeu_ps(floats(data + j + stride * 3), addISse3<inverse>(diffAC, diffBD));
+            }
+
+            radix4Scalar<inverse>(data, twiddles, stride, j);
+        }
+    }
+
+    KLARITY_TARGET("avx2")
+    inline __m256 loadTwiddlesAvx2(const complex *twiddles, const size_t j, const size_t factor, const size_t index) {
+        return _mm256_castpd_ps(_mm256_setr_pd(
+                *reinterpret_cast<const double *>(twiddles + j * factor + index),
+                *reinterpret_cast<const double *>(twiddles + (j + 1) * factor + index),
+                *reinterpret_cast<const double *>(twiddles + (j + 2) * factor + index),
+                *reinterpret_cast<const double *>(twiddles + (j + 3) * factor + index)
+        ));
+    }
+
+    template<bool inverse>
+    KLARITY_TARGET("avx2")
+    inline __m256 mulAvx2(const __m256 a, __m256 b) {
+        if (inverse) {
+            b = _mm256_xor_ps(b, _mm256_setr_ps(0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f));
+        }
+
+        const auto swapped = _mm256_permute_ps(a, _MM_SHUFFLE(2, 3, 0, 1));
+
+        return _mm256_addsub_ps(_mm256_mul_ps(a, _mm256_moveldup_ps(b)), _mm256_mul_ps(swapped, _mm256_movehdup_ps(b)));
+    }
+
+    template<bool flipped>
+    KLARITY_TARGET("avx2")
+    inline __m256 addIAvx2(const __m256 a, const __m256 b) {
+        const auto swapped = _mm256_permute_ps(b, _MM_SHUFFLE(2, 3, 0, 1));
+
+        return flipped ? _mm256_addsub_ps(a, _mm256_xor_ps(swapped, _mm256_set1_ps(-0.0f)))
+                       : _mm256_addsub_ps(a, swapped);
+    }
+
+    template<bool inverse>
+    KLARITY_TARGET("avx2")
+    void radix2Avx2(complex *data, const complex *twiddles, const size_t stride, const size_t outerRepeats) {
+        for (size_t outer = 0; outer < outerRepeats; ++outer, data += stride * 2) {
+            size_t j = 0;
+
+            for (; j + 4 <= stride; j += 4) {
+                const auto a = _mm256_loadu_ps(floats(data + j));
+
+                const auto b = mulAvx2<inverse>(_mm256_loadu_ps(floats(data + j + stride)), loadTwiddlesAvx2(twiddles, j, 2, 1));
+
+                _mm256_storeu_ps(floats(data + j), _mm256_add_ps(a, b));
+
+                _mm256_storeu_ps(floats(data + j + stride), _mm256_sub_ps(a, b));
+            }
+
+            _mm256_zeroupper();
+
+            radix2Scalar<inverse>(data, twiddles, stride, j);
+        }
+    }
+
+    template<bool inverse>
+    KLARITY_TARGET("avx2")
+    void radix4Avx2(complex *data, const complex *twiddles, const size_t stride, const size_t outerRepeats) {
+        for (size_t outer = 0; outer < outerRepeats; ++outer, data += stride * 4) {
+            size_t j = 0;
+
+            for (; j + 4 <= stride; j += 4) {
+                const auto a = _mm256_loadu_ps(floats(data + j));
+
+                const auto c = mulAvx2<inverse>(_mm256_loadu_ps(floats(data + j + stride)), loadTwiddlesAvx2(twiddles, j, 4, 2));
+
+                const auto b = mulAvx2<inverse>(_mm256_loadu_ps(floats(data + j + stride * 2)), loadTwiddlesAvx2(twiddles, j, 4, 1));
+
+                const auto d = mulAvx2<inverse>(_mm256_loadu_ps(floats(data + j + stride * 3)), loadTwiddlesAvx2(twiddles, j, 4, 3));
+
+                const auto sumAC = _mm256_add_ps(a, c), sumBD = _mm256_add_ps(b, d);
+
+                const auto diffAC = _mm256_sub_ps(a, c), diffBD = _mm256_sub_ps(b, d);
+
+                _mm256_storeu_ps(floats(data + j), _mm256_add_ps(sumAC, sumBD));
+
+                _mm256_storeu_ps(floats(data + j + stride), addIAvx2<!inverse>(diffAC, diffBD));
+
+                _mm256_storeu_ps(floats(data + j + stride * 2), _mm256_sub_ps(sumAC, sumBD));
+
+                _mm256_storeu_ps(floats(data + j + stride * 3), addIAvx2<inverse>(diffAC, diffBD));
+            }
+
+            _mm256_zeroupper();
+
+            radix4Scalar<inverse>(data, twiddles, stride, j);
+        }
+    }
+
+#elif defined(KLARITY_BUTTERFLY_NEON)
+
+    inline float *floats(complex *data) {
+        return reinterpret_cast<float *>(data);
+    }
+
+    inline float32x4_t loadTwiddlesNeon(const complex *twiddles, const size_t j, const size_t factor, const size_t index) {
+        return vcombine_f32(
+                vld1_f32(reinterpret_cast<const float *>(twiddles + j * factor + index)),
+                vld1_f32(reinterpret_cast<const float *>(twiddles + (j + 1) * factor + index))
+        );
+    }
+
+    inline float32x4_t negateImagNeon(const float32x4_t value) {
+        const float signs[4] = {1.0f, -1.0f, 1.0f, -1.0f};
+
+        return vmulq_f32(value, vld1q_f32(signs));
+    }
+
+    inline float32x4_t negateRealNeon(const float32x4_t value) {
+        const float signs[4] = {-1.0f, 1.0f, -1.0f, 1.0f};
+
+        return vmulq_f32(value, vld1q_f32(signs));
+    }
+
+    template<bool inverse>
+    inline float32x4_t mulNeon(const float32x4_t a, float32x4_t b) {
+        if (inverse) {
+            b = negateImagNeon(b);
+        }
+
+        const auto products = vmulq_f32(vrev64q_f32(a), vtrn2q_f32(b, b));
+
+        return vaddq_f32(vmulq_f32(a, vtrn1q_f32(b, b)), negateRealNeon(products));
+    }
+
+    template<bool flipped>
+    inline float32x4_t addINeon(const float32x4_t a, const float32x4_t b) {
+        const auto rotated = negateRealNeon(vrev64q_f32(b));
+
+        return flipped ? vsubq_f32(a, rotated) : vaddq_f32(a, rotated);
+    }
+
+    template<bool inverse>
+    void radix2Neon(complex *data, const complex *twiddles, const size_t stride, const size_t outerRepeats) {
+        for (size_t outer = 0; outer < outerRepeats; ++outer, data += stride * 2) {
+            size_t j = 0;
+
+            for (; j + 2 <= stride; j += 2) {
+                const auto a = vld1q_f32(floats(data + j));
+
+                const auto b = mulNeon<inverse>(vld1q_f32(floats(data + j + stride)), loadTwiddlesNeon(twiddles, j, 2, 1));
+
+                vst1q_f32(floats(data + j), vaddq_f32(a, b));
+
+                vst1q_f32(floats(data + j + stride), vsubq_f32(a, b));
+            }
+
+            radix2Scalar<inverse>(data, twiddles, stride, j);
+        }
+    }
+
+    template<bool inverse>
+    void radix4Neon(complex *data, const complex *twiddles, const size_t stride, const size_t outerRepeats) {
+        for (size_t outer = 0; outer < outerRepeats; ++outer, data += stride * 4) {
+            size_t j = 0;
+
+            for (; j + 2 <= stride; j += 2) {
+                const auto a = vld1q_f32(floats(data + j));
+
+                const auto c = mulNeon<inverse>(vld1q_f32(floats(data + j + stride)), loadTwiddlesNeon(twiddles, j, 4, 2));
+
+                const auto b = mulNeon<inverse>(vld1q_f32(floats(data + j + stride * 2)), loadTwiddlesNeon(twiddles, j, 4, 1));
+
+                const auto d = mulNeon<inverse>(vld1q_f32(floats(data + j + stride * 3)), loadTwiddlesNeon(twiddles, j, 4, 3));
+
+                const auto sumAC = vaddq_f32(a, c), sumBD = vaddq_f32(b, d);
+
+                const auto diffAC = vsubq_f32(a, c), diffBD = vsubq_f32(b, d);
+
+                vst1q_f32(floats(data + j), vaddq_f32(sumAC, sumBD));
+
+                vst1q_f32(floats(data + j + stride), addINeon<!inverse>(diffAC, diffBD));
+
+                vst1q_f32(floats(data + j + stride * 2), vsubq_f32(sumAC, sumBD));
+
+                vst1q_f32(floats(data + j + stride * 3), addINeon<inverse>(diffAC, diffBD));
+            }
+
+            radix4Scalar<inverse>(data, twiddles, stride, j);
+        }
+    }
+
+#endif
+}
+
+Butterfly::Kernels Butterfly::scalarKernels() {
+    return Kernels{
+            radix2Fallback<false>,
+            radix2Fallback<true>,
+            radix4Fallback<false>,
+            radix4Fallback<true>
+    };
+}
+
+Butterfly::Kernels Butterfly::selectKernels() {
+#if defined(KLARITY_BUTTERFLY_X86)
+    const auto flags = av_get_cpu_flags();
+
+    if (flags & AV_CPU_FLAG_AVX2) {
+        return Kernels{
+                radix2Avx2<false>,
+                radix2Avx2<true>,
+                radix4Avx2<false>,
+                radix4Avx2<true>
+        };
+    }
+
+    if (flags & AV_CPU_FLAG_SSE3) {
+        return Kernels{
+                radix2Sse3<false>,
+                radix2Sse3<true>,
+                radix4Sse3<false>,
+                radix4Sse3<true>
+        };
+    }
+#elif defined(KLARITY_BUTTERFLY_NEON)
+    return Kernels{
+            radix2Neon<false>,
+            radix2Neon<true>,
+            radix4Neon<false>,
+            radix4Neon<true>
+    };
+#endif
+    return scalarKernels();
+}
+
+#if defined(KLARITY_BENCHMARK)
+Butterfly::Kernels Butterfly::kernels = selectKernels();
+#else
+const Butterfly::Kernels Butterfly::kernels = selectKernels();
+#endif
+
+#if defined(KLARITY_BENCHMARK)
+void Butterfly::setAccelerated(const bool isAccelerated) {
+    kernels = isAccelerated ? selectKernels() : scalarKernels();
+}
+#endif
@@ -0,0 +1,65 @@
+#include "fifo.h"
+
+SampleFifo::SampleFifo(const size_t capacity) {
+    if (capacity == 0) {
+        throw SamplerException("Invalid sample fifo capacity");
+    }
+
+    samples.resize(capacity);
+}
+
+size_t SampleFifo::capacity() const {
+    return samples.size();
+}
+
+size_t SampleFifo::available() const {
+    return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+}
+
+size_t SampleFifo::space() const {
+    return samples.size() - available();
+}
+
+size_t SampleFifo::push(const float *src, const size_t count) {
+    const auto currentTail = tail.load(std::memory_order_relaxed);
+
+    const auto free = samples.size() - (currentTail - head.load(std::memory_order_acquire));
+
+    const auto total = std::min(count, free);
+
+    const auto offset = currentTail % samples.size();
+
+    const auto first = std::min(total, samples.size() - offset);
+
+    std::memcpy(samples.data() + offset, src, first * sizeof(float));
+
+    std::memcpy(samples.data(), src + first, (total - first) * sizeof(float));
+
+    tail.store(currentTail + total, std::memory_order_release);
+
+    return total;
+}
+
+size_t SampleFifo::pop(float *dst, const size_t count) {
+    const auto currentHead = head.load(std::memory_order_relaxed);
+
+    const auto used = tail.load(std::memory_order_acquire) - currentHead;
+
+    const auto total = std::min(count, used);
+
+    const auto offset = currentHead % samples.size();
+
+    const auto first = std::min(total, samples.size() - offset);
+
+    std::memcpy(dst, samples.data() + offset, first * sizeof(float));
+
+    std::memcpy(dst + first, samples.data(), (total - first) * sizeof(float));
+
+    head.store(currentHead + total, std::memory_order_release);
+
+    return total;
+}
+
+void SampleFifo::clear() {
+    head.store(tail.load(std::memory_order_acquire), std::memory_order_release);
+}
@@ -0,0 +1,400 @@
+#include "interleave.h"
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define KLARITY_INTERLEAVE_X86
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define KLARITY_INTERLEAVE_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define KLARITY_TARGET(name) __attribute__((target(name)))
+#else
+#define KLARITY_TARGET(name)
+#endif
+
+namespace {
+    constexpr float MIN_SAMPLE = -1.0f;
+
+    constexpr float MAX_SAMPLE = 1.0f;
+
+    inline float clampSample(const float value) {
+        return std::clamp(value, MIN_SAMPLE, MAX_SAMPLE);
+    }
+
+    inline void scaleScalar(const float *src, float *dst, const int samples, const float gain, int x) {
+        for (; x < samples; ++x) {
+            dst[x] = clampSample(src[x] * gain);
+        }
+    }
+
+    inline void splitScalar(const float *src, float *left, float *right, const int samples, int x) {
+        for (; x < samples; ++x) {
+            left[x] = clampSample(src[x * 2]);
+
+            right[x] = clampSample(src[x * 2 + 1]);
+        }
+    }
+
+    inline void mergeScalar(
+            const float *left,
+            const float *right,
+            float *dst,
+            const int samples,
+            const float gain,
+            int x
+    ) {
+        for (; x < samples; ++x) {
+            dst[x * 2] = clampSample(left[x] * gain);
+
+            dst[x * 2 + 1] = clampSample(right[x] * gain);
+        }
+    }
+
+    void scaleFallback(const float *src, float *dst, const int samples, const float gain) {
+        scaleScalar(src, dst, samples, gain, 0);
+    }
+
+    void splitFallback(const float *src, float *left, float *right, const int samples) {
+        splitScalar(src, left, right, samples, 0);
+    }
+
+    void mergeFallback(const float *left, const float *right, float *dst, const int samples, const float gain) {
+        mergeScalar(left, right, dst, samples, gain, 0);
+    }
+
+#if defined(KLARITY_INTERLEAVE_X86)
+
+    KLARITY_TARGET("sse")
+    inline __m128 clampSse(const __m128 value) {
+        return _mm_min_ps(_mm_max_ps(value, _mm_set1_ps(MIN_SAMPLE)), _mm_set1_ps(MAX_SAMPLE));
+    }
+
+    KLARITY_TARGET("sse")
+    void scaleSse(const float *src, float *dst, const int samples, const float gain) {
+        const auto gains = _mm_set1_ps(gain);
+
+        int x = 0;
+
+        for (; x + 4 <= samples; x += 4) {
+            _mm_storeu_ps(dst + x, clampSse(_mm_mul_ps(_mm_loadu_ps(src + x), gains)));
+        }
+
+        scaleScalar(src, dst, samples, gain, x);
+    }
+
+    KLARITY_TARGET("sse")
+    void splitSse(const float *src, float *left, float *right, const int samples) {
+        int x = 0;
+
+        for (; x + 4 <= samples; x += 4) {
+            const auto a = _mm_loadu_ps(src + x * 2);
+
+            const auto b = _mm_loadu_ps(src + x * 2 + 4);
+
+            _mm_storeu_ps(left + x, clampSse(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0))));
+
+            _mm_storeu_ps(right + x, clampSse(_mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1))));
+        }
+
+        splitScalar(src, left, right, samples, x);
+    }
+
+    KLARITY_TARGET("sse")
+    void mergeSse(const float *left, const float *right, float *dst, const int samples, const float gain) {
+        const auto gains = _mm_set1_ps(gain);
+
+        int x = 0;
+
+        for (; x + 4 <= samples; x += 4) {
+            const auto l = clampSse(_mm_mul_ps(_mm_loadu_ps(left + x), gains));
+
+            const auto r = clampSse(_mm_mul_ps(_mm_loadu_ps(right + x), gains));
+
+            _mm_storeu_ps(dst + x * 2, _mm_unpacklo_ps(l, r));
+
+            _mm_storeu_ps(dst + x * 2 + 4, _mm_unpackhi_ps(l, r));
+        }
+
+        mergeScalar(left, right, dst, samples, gain, x);
+    }
+
+    KLARITY_TARGET("avx2")
+    inline __m256 clampAvx2(const __m256 value) {
+        return _mm256_min_ps(_mm256_max_ps(value, _mm256_set1_ps(MIN_SAMPLE)), _mm256_set1_ps(MAX_SAMPLE));
+    }
+
+    KLARITY_TARGET("avx2")
+    void scaleAvx2(const float *src, float *dst, const int samples, const float gain) {
+        const auto gains = _mm256_set1_ps(gain);
+
+        int x = 0;
+
+        for (; x + 8 <= samples; x += 8) {
+            _mm256_storeu_ps(dst + x, clampAvx2(_mm256_mul_ps(_mm256_loadu_ps(src + x), gains)));
+        }
+
+        scaleScalar(src, dst, samples, gain, x);
+    }
+
+    KLARITY_TARGET("avx2")
+    void splitAvx2(const float *src, float *left, float *right, const int samples) {
+        int x = 0;
+
+        for (; x + 8 <= samples; x += 8) {
+            const auto a = _mm256_loadu_ps(src + x * 2);
+
+            const auto b = _mm256_loadu_ps(src + x * 2 + 8);
+
+            const auto l = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(a, b, 0x88)), 0xD8));
+
+            const auto r = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(a, b, 0xDD)), 0xD8));
+
+            _mm256_storeu_ps(left + x, clampAvx2(l));
+
+            _mm256_storeu_ps(right + x, clampAvx2(r));
+        }
+
+        splitScalar(src, left, right, samples, x);
+    }
+
+    KLARITY_TARGET("avx2")
+    void mergeAvx2(const float *left, const float *right, float *dst, const int samples, const float gain) {
+        const auto gains = _mm256_set1_ps(gain);
+
+        int x = 0;
+
+        for (; x + 8 <= samples; x += 8) {
+            const auto l = clampAvx2(_mm256_mul_ps(_mm256_loadu_ps(left + x), gains));
+
+            const auto r = clampAvx2(_mm256_mul_ps(_mm256_loadu_ps(right + x), gains));
+
+            const auto low = _mm256_unpacklo_ps(l, r);
+
+            const auto high = _mm256_unpackhi_ps(l, r);
+
+            _mm256_storeu_ps(dst + x * 2, _mm256_permute2f128_ps(low, high, 0x20));
+
+            _mm256_storeu_ps(dst + x * 2 + 8, _mm256_permute2f128_ps(low, high, 0x31));
+        }
+
+        mergeScalar(left, right, dst, samples, gain, x);
+    }
+
+#elif defined(KLARITY_INTERLEAVE_NEON)
+
+    inline float32x4_t clampNeon(const float32x4_t value) {
+        return vminq_f32(vmaxq_f32(value, vdupq_n_f32(MIN_SAMPLE)), vdupq_n_f32(MAX_SAMPLE));
+    }
+
+    void scaleNeon(const float *src, float *dst, const int samples, const float gain) {
+        int x = 0;
+
+        for (; x + 4 <= samples; x += 4) {
+            vst1q_f32(dst + x, clampNeon(vmulq_n_f32(vld1q_f32(src + x), gain)));
+        }
+
+        scaleScalar(src, dst, samples, gain, x);
+    }
+
+    void splitNeon(const float *src, float *left, float *right, const int samples) {
+        int x = 0;
+
+        for (; x + 4 <= samples; x += 4) {
+            const auto frames = vld2q_f32(src + x * 2);
+
+            vst1q_f32(left + x, clampNeon(frames.val[0]));
+
+            vst1q_f32(right + x, clampNeon(frames.val[1]));
+        }
+
+        splitScalar(src, left, right, samples, x);
+    }
+
+    void mergeNeon(const float *left, const float *right, float *dst, const int samples, const float gain) {
+        int x = 0;
+
+        for (; x + 4 <= samples; x += 4) {
+            float32x4x2_t frames;
+
+            frames.val[0] = clampNeon(vmulq_n_f32(vld1q_f32(left + x), gain));
+
+            frames.val[1] = clampNeon(vmulq_n_f32(vld1q_f32(right + x), gain));
+
+            vst2q_f32(dst + x * 2, frames);
+        }
+
+        mergeScalar(left, right, dst, samples, gain, x);
+    }
+
+#endif
+}
+
+Interleave::ScaleFunction Interleave::selectScale() {
+#if defined(KLARITY_INTERLEAVE_X86)
+    const auto flags = av_get_cpu_flags();
+
+    if (flags & AV_CPU_FLAG_AVX2) {
+        return scaleAvx2;
+    }
+
+    if (flags & AV_CPU_FLAG_SSE) {
+        return scaleSse;
+    }
+#elif defined(KLARITY_INTERLEAVE_NEON)
+    return scaleNeon;
+#endif
+    return scaleFallback;
+}
+
+Interleave::SplitFunction Interleave::selectSplit() {
+#if defined(KLARITY_INTERLEAVE_X86)
+    const auto flags = av_get_cpu_flags();
+
+    if (flags & AV_CPU_FLAG_AVX2) {
+        return splitAvx2;
+    }
+
+    if (flags & AV_CPU_FLAG_SSE) {
+        return splitSse;
+    }
+#elif defined(KLARITY_INTERLEAVE_NEON)
+    return splitNeon;
+#endif
+    return splitFallback;
+}
+
+Interleave::MergeFunction Interleave::selectMerge() {
+#if defined(KLARITY_INTERLEAVE_X86)
+    const auto flags = av_get_cpu_flags();
+
+    if (flags & AV_CPU_FLAG_AVX2) {
+        return mergeAvx2;
+    }
+
+    if (flags & AV_CPU_FLAG_SSE) {
+        return mergeSse;
+    }
+#elif defined(KLARITY_INTERLEAVE_NEON)
+    return mergeNeon;
+#endif
+    return mergeFallback;
+}
+
+Interleave::ScaleFunction Interleave::scale = selectScale();
+
+Interleave::SplitFunction Interleave::split = selectSplit();
+
+Interleave::MergeFunction Interleave::merge = selectMerge();
+
+template<int Channels>
+void Interleave::_deinterleave(const float *src, float *const *dst, const int channels, const int samples) {
+    const int count = Channels > 0 ? Channels : channels;
+
+    for (int sample = 0; sample < samples; ++sample) {
+        for (int channel = 0; channel < count; ++channel) {
+            dst[channel][sample] = clampSample(src[sample * count + channel]);
+        }
+    }
+}
+
+template<>
+void Interleave::_deinterleave<1>(const float *src, float *const *dst, int, const int samples) {
+    scale(src, dst[0], samples, 1.0f);
+}
+
+template<>
+void Interleave::_deinterleave<2>(const float *src, float *const *dst, int, const int samples) {
+    split(src, dst[0], dst[1], samples);
+}
+
+template<int Channels>
+void Interleave::_interleave(
+        const float *const *src,
+        float *dst,
+        const int channels,
+        const int samples,
+        const float gain
+) {
+    const int count = Channels > 0 ? Channels : channels;
+
+    for (int sample = 0; sample < samples; ++sample) {
+        for (int channel = 0; channel < count; ++channel) {
+            dst[sample * count + channel] = clampSample(src[channel][sample] * gain);
+        }
+    }
+}
+
+template<>
+void Interleave::_interleave<1>(
+        const float *const *src,
+        float *dst,
+        int,
+        const int samples,
+        const float gain
+) {
+    scale(src[0], dst, samples, gain);
+}
+
+template<>
+void Interleave::_interleave<2>(
+        const float *const *src,
+        float *dst,
+        int,
+        const int samples,
+        const float gain
+) {
+    merge(src[0], src[1], dst, samples, gain);
+}
+
+void Interleave::deinterleave(const float *src, float *const *dst, const int channels, const int samples) {
+    switch (channels) {
+        case 1:
+            _deinterleave<1>(src, dst, channels, samples);
+
+            break;
+
+        case 2:
+            _deinterleave<2>(src, dst, channels, samples);
+
+            break;
+
+        default:
+            _deinterleave<0>(src, dst, channels, samples);
+
+            break;
+    }
+}
+
+void Interleave::clamp(const float *const *src, float *const *dst, const int channels, const int samples) {
+    for (int channel = 0; channel < channels; ++channel) {
+        scale(src[channel], dst[channel], samples, 1.0f);
+    }
+}
+
+void Interleave::interleave(
+        const float *const *src,
+        float *dst,
+        const int channels,
+        const int samples,
+        const float gain
+) {
+    switch (channels) {
+        case 1:
+            _interleave<1>(src, dst, channels, samples, gain);
+
+            break;
+
+        case 2:
+            _interleave<2>(src, dst, channels, samples, gain);
+
+            break;
+
+        default:
+            _interleave<0>(src, dst, channels, samples, gain);
+
+            break;
+    }
+}
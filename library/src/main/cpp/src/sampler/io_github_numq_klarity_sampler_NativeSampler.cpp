@@ -4,12 +4,26 @@ JNIEXPORT jlong JNICALL Java_io_github_numq_klarity_sampler_NativeSampler_00024N
         JNIEnv *env,
         jclass thisClass,
         jint sampleRate,
-        jint channels
+        jint channels,
+        jint bufferFrames,
+        jint stretchQuality,
+        jint blockSamples,
+        jint intervalSamples,
+        jint speedMode,
+        jint resamplingInterpolator,
+        jint stretchThreadCount
 ) {
     return handleException<jlong>(env, [&] {
         auto sampler = new Sampler(
                 static_cast<uint32_t>(sampleRate),
-                static_cast<uint32_t>(channels)
+                static_cast<uint32_t>(channels),
+                static_cast<uint32_t>(bufferFrames),
+                static_cast<StretchQuality>(stretchQuality),
+                static_cast<int>(blockSamples),
+                static_cast<int>(intervalSamples),
+                static_cast<SpeedMode>(speedMode),
+                static_cast<ResamplingInterpolator>(resamplingInterpolator),
+                static_cast<int>(stretchThreadCount)
         );
 
         return reinterpret_cast<jlong>(sampler);
@@ -41,11 +55,40 @@ JNIEXPORT void JNICALL Java_io_github_numq_klarity_sampler_NativeSampler_00024Na
 
         auto size = env->GetArrayLength(bytes);
 
-        std::vector<uint8_t> buffer(size);
+        thread_local std::vector<uint8_t> buffer;
+
+        if (buffer.size() < static_cast<size_t>(size)) {
+            buffer.resize(size);
+        }
+
+        env->GetByteArrayRegion(bytes, 0, size, reinterpret_cast<jbyte *>(buffer.data()));
+
+        sampler->write(buffer.data(), static_cast<int>(size), volume, playbackSpeedFactor);
+    });
+}
+
+JNIEXPORT void JNICALL Java_io_github_numq_klarity_sampler_NativeSampler_00024Native_writePlanar(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong samplerHandle,
+        jbyteArray bytes,
+        jfloat volume,
+        jfloat playbackSpeedFactor
+) {
+    return handleException(env, [&] {
+        auto sampler = getSamplerPointer(samplerHandle);
+
+        auto size = env->GetArrayLength(bytes);
+
+        thread_local std::vector<uint8_t> buffer;
+
+        if (buffer.size() < static_cast<size_t>(size)) {
+            buffer.resize(size);
+        }
 
         env->GetByteArrayRegion(bytes, 0, size, reinterpret_cast<jbyte *>(buffer.data()));
 
-        sampler->write(buffer.data(), static_cast<int>(buffer.size()), volume, playbackSpeedFactor);
+        sampler->writePlanar(buffer.data(), static_cast<int>(size), volume, playbackSpeedFactor);
     });
 }
 
@@ -87,6 +130,30 @@ JNIEXPORT void JNICALL Java_io_github_numq_klarity_sampler_NativeSampler_00024Na
     });
 }
 
+JNIEXPORT jlong JNICALL Java_io_github_numq_klarity_sampler_NativeSampler_00024Native_getLatency(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong samplerHandle
+) {
+    return handleException<jlong>(env, [&] {
+        auto sampler = getSamplerPointer(samplerHandle);
+
+        return static_cast<jlong>(sampler->getLatency());
+    }, 0);
+}
+
+JNIEXPORT jlong JNICALL Java_io_github_numq_klarity_sampler_NativeSampler_00024Native_getUnderrunCount(
+        JNIEnv *env,
+        jclass thisClass,
+        jlong samplerHandle
+) {
+    return handleException<jlong>(env, [&] {
+        auto sampler = getSamplerPointer(samplerHandle);
+
+        return static_cast<jlong>(sampler->getUnderrunCount());
+    }, 0);
+}
+
 JNIEXPORT void JNICALL Java_io_github_numq_klarity_sampler_NativeSampler_00024Native_delete(
         JNIEnv *env,
         jclass thisClass,
@@ -0,0 +1,24 @@
+#include "resampler.h"
+
+std::unique_ptr<Resampler> Resampler::create(const ResamplingInterpolator interpolator, const int channels) {
+    switch (interpolator) {
+        case ResamplingInterpolator::LINEAR:
+            return std::make_unique<InterpolatingResampler<signalsmith::delay::InterpolatorLinear<float>>>(channels);
+
+        case ResamplingInterpolator::CUBIC:
+            return std::make_unique<InterpolatingResampler<signalsmith::delay::InterpolatorCubic<float>>>(channels);
+
+        case ResamplingInterpolator::LAGRANGE:
+            return std::make_unique<InterpolatingResampler<signalsmith::delay::InterpolatorLagrange7<float>>>(
+                    channels
+            );
+
+        case ResamplingInterpolator::KAISER_SINC:
+            return std::make_unique<InterpolatingResampler<signalsmith::delay::InterpolatorKaiserSinc20<float>>>(
+                    channels
+            );
+
+        default:
+            throw SamplerException("Unsupported resampling interpolator");
+    }
+}
@@ -1,15 +1,52 @@
 #include "sampler.h"
 
-Sampler::Sampler(uint32_t sampleRate, uint32_t channels) {
+Sampler::Sampler(
+        uint32_t sampleRate,
+        uint32_t channels,
+        uint32_t bufferFrames,
+        StretchQuality stretchQuality,
+        int blockSamples,
+        int intervalSamples,
+        SpeedMode speedMode,
+        ResamplingInterpolator resamplingInterpolator,
+        int stretchThreadCount
+) {
     std::unique_lock<std::shared_mutex> lock(mutex);
 
     this->sampleRate = sampleRate;
 
     this->channels = channels;
 
+    this->speedMode = speedMode;
+
+    if (bufferFrames == 0) {
+        bufferFrames = sampleRate * DEFAULT_BUFFER_MILLIS / 1000;
+    }
+
+    fifo = std::make_unique<SampleFifo>(static_cast<size_t>(bufferFrames) * channels);
+
+    inputBuffers.resize(channels);
+
+    inputPointers.resize(channels);
+
+    inputPlanes.resize(channels);
+
+    outputPlanes.resize(channels);
+
+    outputBuffers.resize(channels);
+
     stretch = std::make_unique<signalsmith::stretch::SignalsmithStretch<float>>();
 
-    stretch->presetDefault(static_cast<int>(channels), static_cast<float>(sampleRate));
+    _configureStretch(stretchQuality, blockSamples, intervalSamples);
+
+    _configureStretchThreads(stretchThreadCount);
+
+    resampler = Resampler::create(resamplingInterpolator, static_cast<int>(channels));
+
+    historyBuffers.assign(
+            channels,
+            std::vector<float>(stretch->blockSamples() + stretch->intervalSamples(), 0.0f)
+    );
 
     PaDeviceIndex deviceIndex = Pa_GetDefaultOutputDevice();
     if (deviceIndex == paNoDevice) {
@@ -32,9 +69,9 @@ Sampler::Sampler(uint32_t sampleRate, uint32_t channels) {
             &outputParameters,
             sampleRate,
             paFramesPerBufferUnspecified,
-            paNoFlag,
-            nullptr,
-            nullptr
+            paClipOff,
+            &Sampler::_callback,
+            this
     )) != paNoError || !rawStream) {
         throw SamplerException(std::string(Pa_GetErrorText(err)));
     }
@@ -42,6 +79,190 @@ Sampler::Sampler(uint32_t sampleRate, uint32_t channels) {
     stream = std::unique_ptr<PaStream, PaStreamDeleter>(rawStream);
 }
 
+Sampler::~Sampler() {
+    isRunning = false;
+
+    if (stream && Pa_IsStreamActive(stream.get()) == 1) {
+        Pa_AbortStream(stream.get());
+    }
+
+    stream.reset();
+}
+
+void Sampler::_configureStretch(StretchQuality stretchQuality, int blockSamples, int intervalSamples) {
+    auto stretchChannels = static_cast<int>(channels);
+
+    auto rate = static_cast<float>(sampleRate);
+
+    if (blockSamples > 0 || intervalSamples > 0) {
+        if (blockSamples <= 0 || intervalSamples <= 0 || intervalSamples > blockSamples) {
+            throw SamplerException("Invalid stretch block or interval size");
+        }
+
+        stretch->configure(stretchChannels, blockSamples, intervalSamples);
+
+        return;
+    }
+
+    switch (stretchQuality) {
+        case StretchQuality::DEFAULT:
+            stretch->presetDefault(stretchChannels, rate);
+
+            break;
+
+        case StretchQuality::CHEAP:
+            stretch->presetCheaper(stretchChannels, rate);
+
+            break;
+
+        case StretchQuality::HIGH:
+            stretch->configure(
+                    stretchChannels,
+                    static_cast<int>(rate * 0.16f),
+                    static_cast<int>(rate * 0.02f)
+            );
+
+            break;
+
+        case StretchQuality::LOW_LATENCY:
+            stretch->configure(
+                    stretchChannels,
+                    static_cast<int>(rate * 0.06f),
+                    static_cast<int>(rate * 0.015f)
+            );
+
+            break;
+
+        default:
+            throw SamplerException("Unsupported stretch quality");
+    }
+}
+
+void Sampler::_configureStretchThreads(const int stretchThreadCount) {
+    if (stretchThreadCount < 0) {
+        throw SamplerException("Invalid stretch thread count");
+    }
+
+    auto &pool = WorkerPool::getShared();
+
+    const auto taskLimit = stretchThreadCount > 0 ? stretchThreadCount : pool.getConcurrency();
+
+    if (taskLimit <= 1 || channels <= 1) {
+        return;
+    }
+
+    using ChannelTask = signalsmith::spectral::STFT<float>::ChannelTask;
+
+    stretch->setParallel([&pool, taskLimit](const int count, const ChannelTask task) {
+        const auto groups = std::min(count, taskLimit);
+
+        pool.run(groups, [&](const int group) {
+            for (int index = group; index < count; index += groups) {
+                task(index);
+            }
+        });
+    });
+}
+
+int Sampler::_callback(
+        const void *input,
+        void *output,
+        unsigned long frameCount,
+        const PaStreamCallbackTimeInfo *timeInfo,
+        PaStreamCallbackFlags statusFlags,
+        void *userData
+) {
+    return static_cast<Sampler *>(userData)->_render(static_cast<float *>(output), frameCount);
+}
+
+int Sampler::_render(float *output, const unsigned long frameCount) {
+    const auto requested = static_cast<size_t>(frameCount) * channels;
+
+    const auto popped = fifo->pop(output, requested);
+
+    playedFrames.fetch_add(popped / channels, std::memory_order_relaxed);
+
+    if (popped < requested) {
+        std::fill(output + popped, output + requested, 0.0f);
+
+        if (isPrimed.exchange(false, std::memory_order_relaxed) && !isDraining.load(std::memory_order_relaxed)) {
+            underruns.fetch_add(1, std::memory_order_relaxed);
+        }
+    } else {
+        isPrimed.store(true, std::memory_order_relaxed);
+    }
+
+    return paContinue;
+}
+
+size_t Sampler::_pushAvailable(const float *buffer, const size_t size) {
+    size_t offset = 0;
+
+    while (offset < size) {
+        offset += fifo->push(buffer + offset, size - offset);
+
+        if (offset == size || !isRunning.load(std::memory_order_acquire)) {
+            break;
+        }
+
+        auto pendingFrames = std::min(size - offset, fifo->capacity() / 2) / channels;
+
+        auto waitMicros = std::max<int64_t>(
+                MIN_WAIT_MICROS,
+                static_cast<int64_t>(pendingFrames) * 1'000'000 / sampleRate
+        );
+
+        std::this_thread::sleep_for(std::chrono::microseconds(waitMicros));
+    }
+
+    return offset;
+}
+
+void Sampler::_push(const float *buffer, const size_t size) {
+    writtenFrames.fetch_add(size / channels, std::memory_order_relaxed);
+
+    auto pushed = pendingSize == 0 ? _pushAvailable(buffer, size) : 0;
+
+    if (pushed == size) {
+        return;
+    }
+
+    _reserveScratch(pendingSamples, pendingSize + size - pushed);
+
+    std::copy(buffer + pushed, buffer + size, pendingSamples.begin() + static_cast<ptrdiff_t>(pendingSize));
+
+    pendingSize += size - pushed;
+}
+
+void Sampler::_pushPending() {
+    if (pendingSize == 0) {
+        return;
+    }
+
+    auto pushed = _pushAvailable(pendingSamples.data(), pendingSize);
+
+    std::copy(
+            pendingSamples.begin() + static_cast<ptrdiff_t>(pushed),
+            pendingSamples.begin() + static_cast<ptrdiff_t>(pendingSize),
+            pendingSamples.begin()
+    );
+
+    pendingSize -= pushed;
+}
+
+void Sampler::_awaitEmpty() {
+    while (fifo->available() > 0 && isRunning.load(std::memory_order_acquire)) {
+        auto pendingFrames = fifo->available() / channels;
+
+        auto waitMicros = std::max<int64_t>(
+                MIN_WAIT_MICROS,
+                static_cast<int64_t>(pendingFrames) * 1'000'000 / sampleRate
+        );
+
+        std::this_thread::sleep_for(std::chrono::microseconds(waitMicros));
+    }
+}
+
 int Sampler::start() {
     std::unique_lock<std::shared_mutex> lock(mutex);
 
@@ -59,21 +280,45 @@ int Sampler::start() {
         throw SamplerException("Failed to start PortAudio stream: " + std::string(Pa_GetErrorText(err)));
     }
 
-    double outputLatency = Pa_GetStreamInfo(stream.get())->outputLatency;
+    isRunning = true;
+
+    return _getLatency(true);
+}
+
+int Sampler::getLatency(const bool isQueueIncluded) {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+
+    if (!stretch || !stream) {
+        throw SamplerException("Unable to get latency of uninitialized sampler");
+    }
+
+    return _getLatency(isQueueIncluded);
+}
 
-    double stretchInputLatency = stretch->inputLatency() / static_cast<double>(sampleRate);
+int Sampler::_getLatency(const bool isQueueIncluded) {
+    double totalLatency = Pa_GetStreamInfo(stream.get())->outputLatency;
 
-    double stretchOutputLatency = stretch->outputLatency() / static_cast<double>(sampleRate);
+    if (isQueueIncluded) {
+        totalLatency += static_cast<double>(fifo->capacity() / channels) / static_cast<double>(sampleRate);
+    }
 
-    double totalLatency = outputLatency + stretchInputLatency + stretchOutputLatency;
+    if (!isBypassing && speedMode == SpeedMode::RESAMPLE) {
+        totalLatency += resampler->getLatency() / static_cast<double>(sampleRate);
+    } else if (!isBypassing) {
+        double stretchInputLatency = stretch->inputLatency() / static_cast<double>(sampleRate);
+
+        double stretchOutputLatency = stretch->outputLatency() / static_cast<double>(sampleRate);
+
+        totalLatency += stretchInputLatency + stretchOutputLatency;
+    }
 
     return static_cast<int>(totalLatency * 1'000'000);
 }
 
 void Sampler::write(const uint8_t *buffer, const int size, const float volume, const float playbackSpeedFactor) {
-    std::unique_lock<std::shared_mutex> lock(mutex);
+    std::unique_lock<std::mutex> lock(writeMutex);
 
-    if (!stretch || !stream || Pa_IsStreamActive(stream.get()) <= 0) {
+    if (!stretch || !stream || !isRunning) {
         throw SamplerException("Unable to play uninitialized sampler");
     }
 
@@ -83,35 +328,196 @@ void Sampler::write(const uint8_t *buffer, const int size, const float volume, c
 
     int inputSamples = static_cast<int>(static_cast<float>(size) / sizeof(float) / static_cast<float>(channels));
 
-    int outputSamples = static_cast<int>(static_cast<float>(inputSamples) / playbackSpeedFactor);
+    _reserveScratch(inputBuffers, inputSamples);
 
-    std::vector<std::vector<float>> inputBuffers(channels, std::vector<float>(inputSamples));
+    auto floatBuffer = reinterpret_cast<const float *>(buffer);
 
-    std::vector<std::vector<float>> outputBuffers(channels, std::vector<float>(outputSamples));
+    for (int channel = 0; channel < channels; ++channel) {
+        inputPointers[channel] = inputBuffers[channel].data();
+
+        inputPlanes[channel] = inputPointers[channel];
+    }
+
+    Interleave::deinterleave(floatBuffer, inputPointers.data(), static_cast<int>(channels), inputSamples);
+
+    _process(inputSamples, volume, playbackSpeedFactor);
+}
+
+void Sampler::writePlanar(
+        const uint8_t *buffer,
+        const int size,
+        const float volume,
+        const float playbackSpeedFactor
+) {
+    std::unique_lock<std::mutex> lock(writeMutex);
+
+    if (!stretch || !stream || !isRunning) {
+        throw SamplerException("Unable to play uninitialized sampler");
+    }
+
+    if (!buffer || size <= 0) {
+        throw SamplerException("Invalid buffer or size");
+    }
+
+    int inputSamples = static_cast<int>(static_cast<size_t>(size) / sizeof(float) / channels);
+
+    _reserveScratch(inputBuffers, inputSamples);
 
     auto floatBuffer = reinterpret_cast<const float *>(buffer);
 
-    for (int sample = 0; sample < inputSamples; ++sample) {
-        for (int channel = 0; channel < channels; ++channel) {
-            inputBuffers[channel][sample] = std::clamp(floatBuffer[sample * channels + channel], -1.0f, 1.0f);
-        }
+    for (int channel = 0; channel < channels; ++channel) {
+        inputPointers[channel] = inputBuffers[channel].data();
+
+        inputPlanes[channel] = floatBuffer + static_cast<ptrdiff_t>(channel) * inputSamples;
+    }
+
+    Interleave::clamp(inputPlanes.data(), inputPointers.data(), static_cast<int>(channels), inputSamples);
+
+    for (int channel = 0; channel < channels; ++channel) {
+        inputPlanes[channel] = inputPointers[channel];
+    }
+
+    _process(inputSamples, volume, playbackSpeedFactor);
+}
+
+void Sampler::_process(const int inputSamples, const float volume, const float playbackSpeedFactor) {
+    _pushPending();
+
+    auto isUnitySpeed = playbackSpeedFactor == 1.0f;
+
+    if (isUnitySpeed && isBypassing) {
+        _updateHistory(inputSamples);
+
+        _writeOutput(inputPlanes.data(), inputSamples, volume);
+
+        return;
+    }
+
+    auto outputSamples = speedMode == SpeedMode::RESAMPLE
+                         ? _resample(inputSamples, playbackSpeedFactor)
+                         : _stretch(inputSamples, playbackSpeedFactor);
+
+    if (isBypassing) {
+        _crossfade(std::min(inputSamples, outputSamples), inputSamples, false);
+
+        isBypassing = false;
+    } else if (isUnitySpeed) {
+        _reserveScratch(outputBuffers, inputSamples);
+
+        _crossfade(std::min(inputSamples, outputSamples), inputSamples, true);
+
+        outputSamples = inputSamples;
+
+        isBypassing = true;
+    }
+
+    _updateHistory(inputSamples);
+
+    _writeOutput(_getOutputPlanes(), outputSamples, volume);
+}
+
+int Sampler::_stretch(const int inputSamples, const float playbackSpeedFactor) {
+    int outputSamples = static_cast<int>(static_cast<float>(inputSamples) / playbackSpeedFactor);
+
+    _reserveScratch(outputBuffers, outputSamples);
+
+    if (isBypassing) {
+        stretch->reset();
+
+        stretch->seek(historyBuffers, static_cast<int>(historyBuffers[0].size()), playbackSpeedFactor);
     }
 
-    stretch->process(inputBuffers, inputSamples, outputBuffers, outputSamples);
+    stretch->process(inputPlanes.data(), inputSamples, outputBuffers, outputSamples);
 
-    if (samples.size() < outputSamples * channels) {
-        samples.resize(outputSamples * channels);
+    return outputSamples;
+}
+
+int Sampler::_resample(const int inputSamples, const float playbackSpeedFactor) {
+    if (isBypassing) {
+        resampler->reset();
     }
 
-    for (int sample = 0; sample < outputSamples; sample++) {
-        for (int channel = 0; channel < channels; channel++) {
-            samples[sample * channels + channel] = std::clamp(outputBuffers[channel][sample] * volume, -1.0f, 1.0f);
+    _reserveScratch(outputBuffers, resampler->getMaxOutputSamples(inputSamples, playbackSpeedFactor));
+
+    return resampler->process(inputPlanes.data(), inputSamples, playbackSpeedFactor, outputBuffers);
+}
+
+void Sampler::_crossfade(const int samples, const int inputSamples, const bool isFadingToInput) {
+    auto fadeSamples = std::min(samples, static_cast<int>(sampleRate * CROSSFADE_MILLIS / 1000));
+
+    for (int channel = 0; channel < channels; ++channel) {
+        auto input = inputPlanes[channel];
+
+        auto &output = outputBuffers[channel];
+
+        for (int sample = 0; sample < fadeSamples; ++sample) {
+            auto weight = static_cast<float>(sample + 1) / static_cast<float>(fadeSamples + 1);
+
+            auto inputWeight = isFadingToInput ? weight : 1.0f - weight;
+
+            output[sample] = input[sample] * inputWeight + output[sample] * (1.0f - inputWeight);
         }
+
+        if (isFadingToInput) {
+            std::copy(input + fadeSamples, input + inputSamples, output.begin() + fadeSamples);
+        }
+    }
+}
+
+void Sampler::_updateHistory(const int inputSamples) {
+    if (speedMode != SpeedMode::STRETCH) {
+        return;
+    }
+
+    auto historySamples = static_cast<int>(historyBuffers[0].size());
+
+    auto count = std::min(inputSamples, historySamples);
+
+    for (int channel = 0; channel < channels; ++channel) {
+        auto &history = historyBuffers[channel];
+
+        std::move(history.begin() + count, history.end(), history.begin());
+
+        auto input = inputPlanes[channel];
+
+        std::copy(input + inputSamples - count, input + inputSamples, history.end() - count);
+    }
+}
+
+void Sampler::_resetHistory() {
+    for (auto &history: historyBuffers) {
+        std::fill(history.begin(), history.end(), 0.0f);
     }
 
-    Pa_WriteStream(stream.get(), samples.data(), samples.size() / channels);
+    isBypassing = true;
+}
+
+const float *const *Sampler::_getOutputPlanes() {
+    for (int channel = 0; channel < channels; ++channel) {
+        outputPlanes[channel] = outputBuffers[channel].data();
+    }
 
-    samples.clear();
+    return outputPlanes.data();
+}
+
+void Sampler::_reserveScratch(std::vector<float> &buffer, const size_t size) {
+    if (buffer.size() < size) {
+        buffer.resize(std::max(size, buffer.size() * 2));
+    }
+}
+
+void Sampler::_reserveScratch(std::vector<std::vector<float>> &buffers, const size_t size) {
+    for (auto &buffer: buffers) {
+        _reserveScratch(buffer, size);
+    }
+}
+
+void Sampler::_writeOutput(const float *const *planes, const int outputSamples, const float volume) {
+    _reserveScratch(samples, static_cast<size_t>(outputSamples) * channels);
+
+    Interleave::interleave(planes, samples.data(), static_cast<int>(channels), outputSamples, volume);
+
+    _push(samples.data(), static_cast<size_t>(outputSamples) * channels);
 }
 
 void Sampler::stop() {
@@ -121,6 +527,8 @@ void Sampler::stop() {
         throw SamplerException("Unable to pause uninitialized sampler");
     }
 
+    isRunning = false;
+
     auto isStreamActive = Pa_IsStreamActive(stream.get());
 
     if (isStreamActive == 1) {
@@ -141,6 +549,8 @@ void Sampler::flush() {
         throw SamplerException("Unable to stop uninitialized sampler");
     }
 
+    isRunning = false;
+
     auto isStreamActive = Pa_IsStreamActive(stream.get());
 
     if (isStreamActive == 1) {
@@ -151,19 +561,29 @@ void Sampler::flush() {
         }
     }
 
+    std::unique_lock<std::mutex> writeLock(writeMutex);
+
     int outputSamples = stretch->outputLatency();
 
-    if (outputSamples > 0) {
-        std::vector<std::vector<float>> outputBuffers(channels, std::vector<float>(outputSamples, 0.0f));
+    if (speedMode == SpeedMode::STRETCH && !isBypassing && outputSamples > 0) {
+        _reserveScratch(outputBuffers, outputSamples);
 
         stretch->flush(outputBuffers, outputSamples);
     }
 
     stretch->reset();
 
-    samples.clear();
+    resampler->reset();
+
+    _resetHistory();
+
+    fifo->clear();
+
+    pendingSize = 0;
 
-    samples.shrink_to_fit();
+    playedFrames = writtenFrames.load();
+
+    isPrimed = false;
 }
 
 void Sampler::drain(const float volume, const float playbackSpeedFactor) {
@@ -173,9 +593,27 @@ void Sampler::drain(const float volume, const float playbackSpeedFactor) {
         throw SamplerException("Unable to drain uninitialized sampler");
     }
 
-    auto isStreamActive = Pa_IsStreamActive(stream.get());
+    std::unique_lock<std::mutex> writeLock(writeMutex);
 
-    if (isStreamActive == 1) {
+    isDraining = true;
+
+    _pushPending();
+
+    auto outputSamples = static_cast<int>(static_cast<float>(stretch->outputLatency()) / playbackSpeedFactor);
+
+    if (speedMode == SpeedMode::STRETCH && !isBypassing && outputSamples > 0) {
+        _reserveScratch(outputBuffers, outputSamples);
+
+        stretch->flush(outputBuffers, outputSamples);
+
+        _writeOutput(_getOutputPlanes(), outputSamples, volume);
+    }
+
+    _awaitEmpty();
+
+    isRunning = false;
+
+    if (Pa_IsStreamActive(stream.get()) == 1) {
         PaError err = Pa_StopStream(stream.get());
 
         if (err != paNoError) {
@@ -183,31 +621,31 @@ void Sampler::drain(const float volume, const float playbackSpeedFactor) {
         }
     }
 
-    auto outputSamples = static_cast<int>(static_cast<float>(stretch->outputLatency()) / playbackSpeedFactor);
+    stretch->reset();
 
-    if (outputSamples > 0) {
-        std::vector<std::vector<float>> outputBuffers(channels, std::vector<float>(outputSamples, 0.0f));
+    resampler->reset();
 
-        stretch->flush(outputBuffers, outputSamples);
+    _resetHistory();
 
-        if (samples.size() < outputSamples * channels) {
-            samples.resize(outputSamples * channels);
-        }
+    fifo->clear();
 
-        for (int sample = 0; sample < outputSamples; sample++) {
-            for (int channel = 0; channel < channels; channel++) {
-                samples[sample * channels + channel] = std::clamp(outputBuffers[channel][sample] * volume, -1.0f, 1.0f);
-            }
-        }
+    pendingSize = 0;
 
-        Pa_WriteStream(stream.get(), samples.data(), samples.size() / channels);
+    playedFrames = writtenFrames.load();
 
-        Pa_StopStream(stream.get());
-    }
+    isPrimed = false;
 
-    stretch->reset();
+    isDraining = false;
+}
 
-    samples.clear();
+uint64_t Sampler::getWrittenFrames() const {
+    return writtenFrames.load(std::memory_order_relaxed);
+}
+
+uint64_t Sampler::getPlayedFrames() const {
+    return playedFrames.load(std::memory_order_relaxed);
+}
 
-    samples.shrink_to_fit();
+uint64_t Sampler::getUnderrunCount() const {
+    return underruns.load(std::memory_order_relaxed);
 }
\ No newline at end of file
@@ -0,0 +1,158 @@
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include "sampler.h"
+
+namespace {
+    constexpr uint32_t SAMPLE_RATE = 48000;
+
+    constexpr uint32_t CHANNELS = 2;
+
+    constexpr int BLOCK_FRAMES = 1024;
+
+    constexpr int WARMUP_ROUNDS = 2;
+
+    constexpr int MEASURED_ROUNDS = 4;
+
+    constexpr float PLAYBACK_SPEEDS[] = {1.0f, 0.5f, 0.75f, 1.5f, 2.0f, 1.0f};
+
+    std::atomic<bool> isCounting{false};
+
+    std::atomic<uint64_t> allocations{0};
+
+    void *allocate(const std::size_t size) {
+        if (isCounting.load(std::memory_order_relaxed)) {
+            allocations.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (auto pointer = std::malloc(size > 0 ? size : 1)) {
+            return pointer;
+        }
+
+        throw std::bad_alloc();
+    }
+
+    void writeRound(Sampler &sampler, const std::vector<float> &interleaved, const std::vector<float> &planar) {
+        const auto size = static_cast<int>(interleaved.size() * sizeof(float));
+
+        for (const auto playbackSpeedFactor: PLAYBACK_SPEEDS) {
+            sampler.write(reinterpret_cast<const uint8_t *>(interleaved.data()), size, 0.0f, playbackSpeedFactor);
+
+            sampler.writePlanar(reinterpret_cast<const uint8_t *>(planar.data()), size, 0.0f, playbackSpeedFactor);
+        }
+    }
+
+    bool measure(const char *name, const SpeedMode speedMode, const int stretchThreadCount) {
+        std::vector<float> interleaved(BLOCK_FRAMES * CHANNELS);
+
+        std::vector<float> planar(BLOCK_FRAMES * CHANNELS);
+
+        for (int frame = 0; frame < BLOCK_FRAMES; ++frame) {
+            const auto time = static_cast<double>(frame) / SAMPLE_RATE;
+
+            for (uint32_t channel = 0; channel < CHANNELS; ++channel) {
+                const auto value = static_cast<float>(0.3 * std::sin(2.0 * M_PI * 220.0 * (channel + 1) * time));
+
+                interleaved[frame * CHANNELS + channel] = value;
+
+                planar[channel * BLOCK_FRAMES + frame] = value;
+            }
+        }
+
+        Sampler sampler(
+                SAMPLE_RATE,
+                CHANNELS,
+                0,
+                StretchQuality::DEFAULT,
+                0,
+                0,
+                speedMode,
+                ResamplingInterpolator::CUBIC,
+                stretchThreadCount
+        );
+
+        sampler.start();
+
+        for (int round = 0; round < WARMUP_ROUNDS; ++round) {
+            writeRound(sampler, interleaved, planar);
+        }
+
+        allocations = 0;
+
+        isCounting = true;
+
+        for (int round = 0; round < MEASURED_ROUNDS; ++round) {
+            writeRound(sampler, interleaved, planar);
+        }
+
+        isCounting = false;
+
+        sampler.stop();
+
+        const auto count = allocations.load();
+
+        std::printf("%s: %llu allocations over %d writes\n",
+                    name,
+                    static_cast<unsigned long long>(count),
+                    MEASURED_ROUNDS * static_cast<int>(std::size(PLAYBACK_SPEEDS)) * 2);
+
+        return count == 0;
+    }
+}
+
+void *operator new(const std::size_t size) {
+    return allocate(size);
+}
+
+void *operator new[](const std::size_t size) {
+    return allocate(size);
+}
+
+void operator delete(void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+int main() {
+    if (Pa_Initialize() != paNoError) {
+        std::fprintf(stderr, "Could not initialize PortAudio\n");
+
+        return 1;
+    }
+
+    bool isValid = true;
+
+    try {
+        isValid &= measure("stretch", SpeedMode::STRETCH, 1);
+
+        isValid &= measure("parallel stretch", SpeedMode::STRETCH, 2);
+
+        isValid &= measure("resample", SpeedMode::RESAMPLE, 1);
+    } catch (const std::exception &e) {
+        std::fprintf(stderr, "%s\n", e.what());
+
+        isValid = false;
+    }
+
+    Pa_Terminate();
+
+    if (!isValid) {
+        std::fprintf(stderr, "Sampler allocated on the write path\n");
+    }
+
+    return isValid ? 0 : 1;
+}
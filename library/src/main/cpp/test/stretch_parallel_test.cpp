@@ -0,0 +1,100 @@
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "stretch.h"
+#include "workers.h"
+
+namespace {
+    constexpr int SAMPLE_RATE = 48000;
+
+    constexpr int BLOCK_FRAMES = 1024;
+
+    constexpr int BLOCK_COUNT = 48;
+
+    constexpr int HELPER_THREADS = 3;
+
+    constexpr long SEED = 42;
+
+    constexpr double PLAYBACK_SPEEDS[] = {0.5, 0.75, 1.5, 2.0};
+
+    std::vector<std::vector<float>> render(const int channels, WorkerPool *pool) {
+        signalsmith::stretch::SignalsmithStretch<float> stretch(SEED);
+
+        stretch.presetDefault(channels, SAMPLE_RATE);
+
+        if (pool) {
+            using ChannelTask = signalsmith::spectral::STFT<float>::ChannelTask;
+
+            stretch.setParallel([pool](const int count, const ChannelTask task) {
+                pool->run(count, task);
+            });
+        }
+
+        std::mt19937 random(SEED);
+
+        std::uniform_real_distribution<float> distribution(-0.1f, 0.1f);
+
+        std::vector<std::vector<float>> input(channels, std::vector<float>(BLOCK_FRAMES));
+
+        std::vector<std::vector<float>> output(channels, std::vector<float>(BLOCK_FRAMES * 2));
+
+        std::vector<std::vector<float>> rendered(channels);
+
+        long frame = 0;
+
+        for (int block = 0; block < BLOCK_COUNT; ++block) {
+            const auto playbackSpeed = PLAYBACK_SPEEDS[block % std::size(PLAYBACK_SPEEDS)];
+
+            const auto outputFrames = static_cast<int>(std::round(BLOCK_FRAMES / playbackSpeed));
+
+            for (int channel = 0; channel < channels; ++channel) {
+                for (int i = 0; i < BLOCK_FRAMES; ++i) {
+                    const auto time = static_cast<double>(frame + i) / SAMPLE_RATE;
+
+                    input[channel][i] = static_cast<float>(
+                            0.3 * std::sin(2.0 * M_PI * 220.0 * (channel + 1) * time)
+                    ) + distribution(random);
+                }
+            }
+
+            frame += BLOCK_FRAMES;
+
+            stretch.process(input, BLOCK_FRAMES, output, outputFrames);
+
+            for (int channel = 0; channel < channels; ++channel) {
+                rendered[channel].insert(
+                        rendered[channel].end(),
+                        output[channel].begin(),
+                        output[channel].begin() + outputFrames
+                );
+            }
+        }
+
+        return rendered;
+    }
+}
+
+int main() {
+    WorkerPool pool(HELPER_THREADS);
+
+    bool isValid = true;
+
+    for (const int channels: {1, 2, 6, 8}) {
+        const auto serial = render(channels, nullptr);
+
+        const auto parallel = render(channels, &pool);
+
+        const auto isIdentical = serial == parallel;
+
+        std::printf("%d channels: %s\n", channels, isIdentical ? "identical" : "different");
+
+        isValid &= isIdentical;
+    }
+
+    if (!isValid) {
+        std::fprintf(stderr, "Parallel output differs from serial output\n");
+    }
+
+    return isValid ? 0 : 1;
+}
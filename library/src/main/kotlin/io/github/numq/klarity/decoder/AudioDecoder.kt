@@ -32,6 +32,13 @@ internal class AudioDecoder(
 
     override suspend fun decodeVideo(data: Data) = error("Decoder does not support video")
 
+    override suspend fun decodeThumbnails(
+        timestamps: List<Duration>,
+        width: Int,
+        height: Int,
+        keyFramesOnly: Boolean,
+    ) = error("Decoder does not support video")
+
     override suspend fun seekTo(timestamp: Duration, keyFramesOnly: Boolean) = mutex.withLock {
         nativeDecoder.seekTo(timestamp.inWholeMicroseconds, keyFramesOnly)
     }
@@ -4,9 +4,9 @@ import io.github.numq.klarity.factory.Factory
 import io.github.numq.klarity.format.Format
 
 internal class AudioDecoderFactory : Factory<AudioDecoderFactory.Parameters, Decoder<Format.Audio>> {
-    data class Parameters(val location: String)
+    data class Parameters(val location: String, val sampleRate: Int? = null, val channels: Int? = null)
 
     override fun create(parameters: Parameters) = with(parameters) {
-        Decoder.createAudioDecoder(location = location)
+        Decoder.createAudioDecoder(location = location, sampleRate = sampleRate, channels = channels)
     }
 }
\ No newline at end of file
@@ -19,6 +19,13 @@ internal interface Decoder<Format> {
 
     suspend fun decodeVideo(data: Data): Result<Frame>
 
+    suspend fun decodeThumbnails(
+        timestamps: List<Duration>,
+        width: Int,
+        height: Int,
+        keyFramesOnly: Boolean,
+    ): Result<List<Frame.Content.Video?>>
+
     suspend fun seekTo(timestamp: Duration, keyFramesOnly: Boolean): Result<Unit>
 
     suspend fun reset(): Result<Unit>
@@ -72,13 +79,19 @@ internal interface Decoder<Format> {
             }
         }
 
-        fun createAudioDecoder(location: String): Result<Decoder<Format.Audio>> = runCatching {
+        fun createAudioDecoder(
+            location: String,
+            sampleRate: Int? = null,
+            channels: Int? = null,
+        ): Result<Decoder<Format.Audio>> = runCatching {
             val nativeDecoder = NativeDecoder(
                 location = location,
                 findAudioStream = true,
                 findVideoStream = false,
                 decodeAudioStream = true,
-                decodeVideoStream = false
+                decodeVideoStream = false,
+                outputSampleRate = sampleRate ?: 0,
+                outputChannels = channels ?: 0
             )
 
             try {
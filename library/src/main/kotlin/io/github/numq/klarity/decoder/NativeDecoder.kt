@@ -1,11 +1,15 @@
 package io.github.numq.klarity.decoder
 
 import io.github.numq.klarity.cleaner.NativeCleaner
+import io.github.numq.klarity.format.NativeAudioOutputFormat
 import io.github.numq.klarity.format.NativeFormat
+import io.github.numq.klarity.format.NativeVideoOutputFormat
+import io.github.numq.klarity.frame.NativeAudioChunk
 import io.github.numq.klarity.frame.NativeAudioFrame
 import io.github.numq.klarity.frame.NativeVideoFrame
 import java.io.Closeable
 import java.util.concurrent.atomic.AtomicLong
+import kotlin.time.Duration
 
 internal class NativeDecoder(
     location: String,
@@ -14,6 +18,14 @@ internal class NativeDecoder(
     decodeAudioStream: Boolean,
     decodeVideoStream: Boolean,
     hardwareAccelerationCandidates: IntArray? = null,
+    readAheadFrames: Int = 0,
+    videoOutputFormat: NativeVideoOutputFormat = NativeVideoOutputFormat.BGRA,
+    threadCount: Int = 0,
+    threadType: NativeThreadType = NativeThreadType.AUTO,
+    decodingProfile: NativeDecodingProfile = NativeDecodingProfile.LATENCY,
+    outputSampleRate: Int = 0,
+    outputChannels: Int = 0,
+    audioOutputFormat: NativeAudioOutputFormat = NativeAudioOutputFormat.FLT,
 ) : Closeable {
     private object Native {
         @JvmStatic
@@ -27,6 +39,14 @@ internal class NativeDecoder(
             decodeAudioStream: Boolean,
             decodeVideoStream: Boolean,
             hardwareAccelerationCandidates: IntArray,
+            readAheadFrames: Int,
+            videoOutputFormat: Int,
+            threadCount: Int,
+            threadType: Int,
+            decodingProfile: Int,
+            sampleRate: Int,
+            channels: Int,
+            audioOutputFormat: Int,
         ): Long
 
         @JvmStatic
@@ -35,9 +55,32 @@ internal class NativeDecoder(
         @JvmStatic
         external fun decodeAudio(handle: Long): NativeAudioFrame?
 
+        @JvmStatic
+        external fun decodeAudioInto(handle: Long, buffer: Long, capacity: Int): NativeAudioChunk?
+
         @JvmStatic
         external fun decodeVideo(handle: Long, buffer: Long, capacity: Int): NativeVideoFrame?
 
+        @JvmStatic
+        external fun decodeThumbnails(
+            handle: Long,
+            timestampsMicros: LongArray,
+            width: Int,
+            height: Int,
+            keyFramesOnly: Boolean,
+            buffer: Long,
+            capacity: Int,
+        ): Array<NativeVideoFrame?>
+
+        @JvmStatic
+        external fun getKeyframes(handle: Long): LongArray?
+
+        @JvmStatic
+        external fun setAudioChunkSize(handle: Long, samples: Int)
+
+        @JvmStatic
+        external fun setOutputSize(handle: Long, width: Int, height: Int)
+
         @JvmStatic
         external fun seekTo(handle: Long, timestampMicros: Long, keyFramesOnly: Boolean)
 
@@ -67,6 +110,12 @@ internal class NativeDecoder(
     }
 
     init {
+        require(readAheadFrames >= 0) { "Invalid read-ahead frame count" }
+
+        require(threadCount >= 0) { "Invalid thread count" }
+
+        require(outputSampleRate >= 0 && outputChannels >= 0) { "Invalid audio output parameters" }
+
         nativeHandle.set(
             Native.create(
                 location = location,
@@ -74,18 +123,27 @@ internal class NativeDecoder(
                 findVideoStream = findVideoStream,
                 decodeAudioStream = decodeAudioStream,
                 decodeVideoStream = decodeVideoStream,
-                hardwareAccelerationCandidates = hardwareAccelerationCandidates ?: intArrayOf()
+                hardwareAccelerationCandidates = hardwareAccelerationCandidates ?: intArrayOf(),
+                readAheadFrames = readAheadFrames,
+                videoOutputFormat = videoOutputFormat.ordinal,
+                threadCount = threadCount,
+                threadType = threadType.ordinal,
+                decodingProfile = decodingProfile.ordinal,
+                sampleRate = outputSampleRate,
+                channels = outputChannels,
+                audioOutputFormat = audioOutputFormat.ordinal
             )
         )
 
         require(nativeHandle.get() != -1L) { "Could not instantiate native decoder" }
     }
 
-    val format = runCatching {
+    var format = runCatching {
         ensureOpen()
 
         Native.getFormat(handle = nativeHandle.get())
     }
+        private set
 
     fun getNativeHandle(): Long {
         ensureOpen()
@@ -99,12 +157,75 @@ internal class NativeDecoder(
         Native.decodeAudio(handle = nativeHandle.get())
     }
 
+    fun decodeAudio(buffer: Long, capacity: Int) = runCatching {
+        ensureOpen()
+
+        Native.decodeAudioInto(handle = nativeHandle.get(), buffer = buffer, capacity = capacity)
+    }
+
     fun decodeVideo(buffer: Long, capacity: Int) = runCatching {
         ensureOpen()
 
         Native.decodeVideo(handle = nativeHandle.get(), buffer = buffer, capacity = capacity)
     }
 
+    fun decodeThumbnails(
+        timestampsMicros: LongArray,
+        width: Int,
+        height: Int,
+        keyFramesOnly: Boolean,
+        buffer: Long,
+        capacity: Int,
+    ) = runCatching {
+        ensureOpen()
+
+        Native.decodeThumbnails(
+            handle = nativeHandle.get(),
+            timestampsMicros = timestampsMicros,
+            width = width,
+            height = height,
+            keyFramesOnly = keyFramesOnly,
+            buffer = buffer,
+            capacity = capacity
+        ).toList()
+    }
+
+    fun getKeyframes() = runCatching {
+        ensureOpen()
+
+        val values = Native.getKeyframes(handle = nativeHandle.get()) ?: longArrayOf()
+
+        List(values.size / 2) { index ->
+            NativeKeyframe(timestampMicros = values[index * 2], gopFrames = values[index * 2 + 1].toInt())
+        }
+    }
+
+    fun setAudioChunkSize(samples: Int) = runCatching {
+        ensureOpen()
+
+        Native.setAudioChunkSize(handle = nativeHandle.get(), samples = samples)
+
+        format = runCatching {
+            Native.getFormat(handle = nativeHandle.get())
+        }
+    }
+
+    fun setAudioChunkDuration(duration: Duration) = format.mapCatching { nativeFormat ->
+        setAudioChunkSize(
+            samples = (duration.inWholeMicroseconds * nativeFormat.sampleRate / 1_000_000L).toInt()
+        ).getOrThrow()
+    }
+
+    fun setOutputSize(width: Int, height: Int) = runCatching {
+        ensureOpen()
+
+        Native.setOutputSize(handle = nativeHandle.get(), width = width, height = height)
+
+        format = runCatching {
+            Native.getFormat(handle = nativeHandle.get())
+        }
+    }
+
     fun seekTo(timestampMicros: Long, keyFramesOnly: Boolean) = runCatching {
         ensureOpen()
 
@@ -0,0 +1,6 @@
+package io.github.numq.klarity.decoder
+
+internal enum class NativeDecodingProfile {
+    LATENCY,
+    THROUGHPUT,
+}
\ No newline at end of file
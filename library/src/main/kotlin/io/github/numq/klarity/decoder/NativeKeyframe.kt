@@ -0,0 +1,6 @@
+package io.github.numq.klarity.decoder
+
+internal data class NativeKeyframe(
+    val timestampMicros: Long,
+    val gopFrames: Int
+)
\ No newline at end of file
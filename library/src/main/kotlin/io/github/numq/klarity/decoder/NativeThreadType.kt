@@ -0,0 +1,8 @@
+package io.github.numq.klarity.decoder
+
+internal enum class NativeThreadType {
+    AUTO,
+    NONE,
+    FRAME,
+    SLICE,
+}
\ No newline at end of file
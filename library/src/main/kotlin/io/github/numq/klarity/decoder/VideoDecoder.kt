@@ -19,21 +19,54 @@ internal class VideoDecoder(
     override suspend fun decodeAudio() = error("Decoder does not support audio")
 
     override suspend fun decodeVideo(data: Data) = mutex.withLock {
-        nativeDecoder.format.mapCatching { format ->
-            nativeDecoder.decodeVideo(buffer = data.writableData(), capacity = data.size).mapCatching { nativeFrame ->
-                when (nativeFrame) {
-                    null -> Frame.EndOfStream
+        nativeDecoder.decodeVideo(buffer = data.writableData(), capacity = data.size).mapCatching { nativeFrame ->
+            when (nativeFrame) {
+                null -> Frame.EndOfStream
 
-                    else -> with(nativeFrame) {
+                else -> with(nativeFrame) {
+                    Frame.Content.Video(
+                        data = data.makeSubset(0, remaining),
+                        timestamp = timestampMicros.microseconds,
+                        width = width,
+                        height = height
+                    )
+                }
+            }
+        }
+    }
+
+    override suspend fun decodeThumbnails(
+        timestamps: List<Duration>,
+        width: Int,
+        height: Int,
+        keyFramesOnly: Boolean,
+    ) = mutex.withLock {
+        runCatching {
+            val thumbnailSize = width * height * 4
+
+            val data = Data.makeUninitialized(maxOf(1, thumbnailSize * timestamps.size))
+
+            try {
+                nativeDecoder.decodeThumbnails(
+                    timestampsMicros = timestamps.map(Duration::inWholeMicroseconds).toLongArray(),
+                    width = width,
+                    height = height,
+                    keyFramesOnly = keyFramesOnly,
+                    buffer = data.writableData(),
+                    capacity = data.size
+                ).getOrThrow().mapIndexed { index, nativeFrame ->
+                    nativeFrame?.run {
                         Frame.Content.Video(
-                            data = data.makeSubset(0, remaining),
+                            data = data.makeSubset(index * thumbnailSize, remaining),
                             timestamp = timestampMicros.microseconds,
-                            width = format.width,
-                            height = format.height
+                            width = this.width,
+                            height = this.height
                         )
                     }
                 }
-            }.getOrThrow()
+            } finally {
+                data.close()
+            }
         }
     }
 
@@ -0,0 +1,7 @@
+package io.github.numq.klarity.format
+
+internal enum class NativeAudioOutputFormat {
+    FLT,
+    S16,
+    FLTP,
+}
\ No newline at end of file
@@ -5,9 +5,53 @@ internal data class NativeFormat(
     val durationMicros: Long,
     val sampleRate: Int,
     val channels: Int,
+    val audioBufferCapacity: Int,
+    val audioSampleFormat: Int,
     val width: Int,
     val height: Int,
     val frameRate: Double,
     val hwDeviceType: Int,
-    val videoBufferCapacity: Int
-)
\ No newline at end of file
+    val videoBufferCapacity: Int,
+    val videoPixelFormat: Int,
+    val videoStrides: IntArray
+) {
+    override fun equals(other: Any?): Boolean {
+        if (this === other) return true
+        if (javaClass != other?.javaClass) return false
+
+        other as NativeFormat
+
+        if (location != other.location) return false
+        if (durationMicros != other.durationMicros) return false
+        if (sampleRate != other.sampleRate) return false
+        if (channels != other.channels) return false
+        if (audioBufferCapacity != other.audioBufferCapacity) return false
+        if (audioSampleFormat != other.audioSampleFormat) return false
+        if (width != other.width) return false
+        if (height != other.height) return false
+        if (frameRate != other.frameRate) return false
+        if (hwDeviceType != other.hwDeviceType) return false
+        if (videoBufferCapacity != other.videoBufferCapacity) return false
+        if (videoPixelFormat != other.videoPixelFormat) return false
+        if (!videoStrides.contentEquals(other.videoStrides)) return false
+
+        return true
+    }
+
+    override fun hashCode(): Int {
+        var result = location.hashCode()
+        result = 31 * result + durationMicros.hashCode()
+        result = 31 * result + sampleRate
+        result = 31 * result + channels
+        result = 31 * result + audioBufferCapacity
+        result = 31 * result + audioSampleFormat
+        result = 31 * result + width
+        result = 31 * result + height
+        result = 31 * result + frameRate.hashCode()
+        result = 31 * result + hwDeviceType
+        result = 31 * result + videoBufferCapacity
+        result = 31 * result + videoPixelFormat
+        result = 31 * result + videoStrides.contentHashCode()
+        return result
+    }
+}
\ No newline at end of file
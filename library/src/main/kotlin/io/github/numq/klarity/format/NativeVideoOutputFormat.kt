@@ -0,0 +1,6 @@
+package io.github.numq.klarity.format
+
+internal enum class NativeVideoOutputFormat {
+    BGRA,
+    YUV,
+}
\ No newline at end of file
@@ -23,7 +23,14 @@ internal data class NativeAudioFrame(
     }
 }
 
-internal data class NativeVideoFrame(
+internal data class NativeAudioChunk(
     val remaining: Int,
     val timestampMicros: Long
+)
+
+internal data class NativeVideoFrame(
+    val remaining: Int,
+    val timestampMicros: Long,
+    val width: Int,
+    val height: Int
 )
\ No newline at end of file
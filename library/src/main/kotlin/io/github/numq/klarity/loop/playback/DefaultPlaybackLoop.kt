@@ -28,8 +28,6 @@ internal class DefaultPlaybackLoop(
     private val videoClock = AtomicReference(Duration.INFINITE)
 
     private suspend fun Pipeline.AudioPipeline.handleAudioPlayback(onTimestamp: suspend (Duration) -> Unit) {
-        val latency = sampler.getLatency().getOrThrow().microseconds
-
         while (currentCoroutineContext().isActive) {
             val frame = buffer.take().getOrThrow()
 
@@ -37,6 +35,8 @@ internal class DefaultPlaybackLoop(
 
             when (frame) {
                 is Frame.Content.Audio -> {
+                    val latency = sampler.getLatency().getOrThrow().microseconds
+
                     val frameTime = frame.timestamp - latency
 
                     audioClock.set(frameTime)
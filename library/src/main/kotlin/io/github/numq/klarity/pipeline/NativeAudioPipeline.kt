@@ -0,0 +1,117 @@
+package io.github.numq.klarity.pipeline
+
+import io.github.numq.klarity.cleaner.NativeCleaner
+import io.github.numq.klarity.decoder.NativeDecoder
+import io.github.numq.klarity.sampler.NativeSampler
+import java.io.Closeable
+import java.util.concurrent.atomic.AtomicLong
+
+internal class NativeAudioPipeline(
+    private val decoder: NativeDecoder,
+    private val sampler: NativeSampler,
+) : Closeable {
+    private object Native {
+        @JvmStatic
+        external fun create(decoderHandle: Long, samplerHandle: Long): Long
+
+        @JvmStatic
+        external fun start(handle: Long)
+
+        @JvmStatic
+        external fun stop(handle: Long)
+
+        @JvmStatic
+        external fun seekTo(handle: Long, timestampMicros: Long)
+
+        @JvmStatic
+        external fun setVolume(handle: Long, volume: Float)
+
+        @JvmStatic
+        external fun setPlaybackSpeed(handle: Long, factor: Float)
+
+        @JvmStatic
+        external fun getTimestampMicros(handle: Long): Long
+
+        @JvmStatic
+        external fun isCompleted(handle: Long): Boolean
+
+        @JvmStatic
+        external fun delete(handle: Long)
+    }
+
+    private val nativeHandle = AtomicLong(-1L)
+
+    private val cleanable = NativeCleaner.cleaner.register(this) {
+        val handle = nativeHandle.get()
+
+        if (handle != -1L && nativeHandle.compareAndSet(handle, -1L)) {
+            Native.delete(handle = handle)
+        }
+
+        sampler.close()
+
+        decoder.close()
+    }
+
+    private fun ensureOpen() {
+        check(nativeHandle.get() != -1L) { "Native audio pipeline is closed" }
+    }
+
+    init {
+        nativeHandle.set(
+            Native.create(decoderHandle = decoder.getNativeHandle(), samplerHandle = sampler.getNativeHandle())
+        )
+
+        require(nativeHandle.get() != -1L) { "Could not instantiate native audio pipeline" }
+    }
+
+    fun start() = runCatching {
+        ensureOpen()
+
+        Native.start(handle = nativeHandle.get())
+    }
+
+    fun stop() = runCatching {
+        ensureOpen()
+
+        Native.stop(handle = nativeHandle.get())
+    }
+
+    fun seekTo(timestampMicros: Long) = runCatching {
+        ensureOpen()
+
+        require(timestampMicros >= 0L) { "Timestamp must be non-negative" }
+
+        Native.seekTo(handle = nativeHandle.get(), timestampMicros = timestampMicros)
+    }
+
+    fun setVolume(volume: Float) = runCatching {
+        ensureOpen()
+
+        require(volume in 0.0..1.0) { "Volume must be between 0.0 and 1.0" }
+
+        Native.setVolume(handle = nativeHandle.get(), volume = volume)
+    }
+
+    fun setPlaybackSpeed(playbackSpeedFactor: Float) = runCatching {
+        ensureOpen()
+
+        require(playbackSpeedFactor in 0.5..2.0) { "Playback speed factor must be between 0.5 and 2.0" }
+
+        Native.setPlaybackSpeed(handle = nativeHandle.get(), factor = playbackSpeedFactor)
+    }
+
+    fun getTimestampMicros() = runCatching {
+        ensureOpen()
+
+        Native.getTimestampMicros(handle = nativeHandle.get())
+    }
+
+    fun isCompleted() = runCatching {
+        ensureOpen()
+
+        Native.isCompleted(handle = nativeHandle.get())
+    }
+
+    override fun close() = cleanable.clean()
+}
\ No newline at end of file
@@ -0,0 +1,3 @@
+package io.github.numq.klarity.pipeline
+
+class PipelineException(override val message: String) : Exception(message)
\ No newline at end of file
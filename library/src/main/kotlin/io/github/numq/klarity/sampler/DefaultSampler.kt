@@ -9,14 +9,12 @@ internal class DefaultSampler(
 ) : Sampler {
     private val mutex = Mutex()
 
-    private var latency = 0L
-
-    override suspend fun getLatency() = mutex.withLock { Result.success(latency) }
+    override suspend fun getLatency() = mutex.withLock {
+        sampler.getLatency()
+    }
 
     override suspend fun start() = mutex.withLock {
-        sampler.start().map {
-            latency = it
-        }
+        sampler.start().map { }
     }
 
     override suspend fun write(frame: Frame.Content.Audio, volume: Float, playbackSpeedFactor: Float) = mutex.withLock {
@@ -0,0 +1,8 @@
+package io.github.numq.klarity.sampler
+
+internal enum class NativeResamplingInterpolator {
+    LINEAR,
+    CUBIC,
+    LAGRANGE,
+    KAISER_SINC,
+}
\ No newline at end of file
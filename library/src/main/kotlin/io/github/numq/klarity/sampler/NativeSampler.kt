@@ -4,10 +4,30 @@ import io.github.numq.klarity.cleaner.NativeCleaner
 import java.io.Closeable
 import java.util.concurrent.atomic.AtomicLong
 
-internal class NativeSampler(sampleRate: Int, channels: Int) : Closeable {
+internal class NativeSampler(
+    sampleRate: Int,
+    channels: Int,
+    bufferFrames: Int = 0,
+    stretchQuality: NativeStretchQuality = NativeStretchQuality.DEFAULT,
+    blockSamples: Int = 0,
+    intervalSamples: Int = 0,
+    speedMode: NativeSpeedMode = NativeSpeedMode.STRETCH,
+    resamplingInterpolator: NativeResamplingInterpolator = NativeResamplingInterpolator.CUBIC,
+    stretchThreadCount: Int = 1,
+) : Closeable {
     private object Native {
         @JvmStatic
-        external fun create(sampleRate: Int, channels: Int): Long
+        external fun create(
+            sampleRate: Int,
+            channels: Int,
+            bufferFrames: Int,
+            stretchQuality: Int,
+            blockSamples: Int,
+            intervalSamples: Int,
+            speedMode: Int,
+            resamplingInterpolator: Int,
+            stretchThreadCount: Int,
+        ): Long
 
         @JvmStatic
         external fun start(handle: Long): Long
@@ -15,6 +35,9 @@ internal class NativeSampler(sampleRate: Int, channels: Int) : Closeable {
         @JvmStatic
         external fun write(handle: Long, bytes: ByteArray, volume: Float, playbackSpeedFactor: Float)
 
+        @JvmStatic
+        external fun writePlanar(handle: Long, bytes: ByteArray, volume: Float, playbackSpeedFactor: Float)
+
         @JvmStatic
         external fun stop(handle: Long)
 
@@ -24,6 +47,12 @@ internal class NativeSampler(sampleRate: Int, channels: Int) : Closeable {
         @JvmStatic
         external fun drain(handle: Long, volume: Float, playbackSpeedFactor: Float)
 
+        @JvmStatic
+        external fun getLatency(handle: Long): Long
+
+        @JvmStatic
+        external fun getUnderrunCount(handle: Long): Long
+
         @JvmStatic
         external fun delete(handle: Long)
     }
@@ -47,11 +76,35 @@ internal class NativeSampler(sampleRate: Int, channels: Int) : Closeable {
 
         require(channels > 0) { "Invalid channels" }
 
-        nativeHandle.set(Native.create(sampleRate = sampleRate, channels = channels))
+        require(bufferFrames >= 0) { "Invalid buffer frames" }
+
+        require(blockSamples >= 0 && intervalSamples >= 0) { "Invalid stretch block or interval size" }
+
+        require(stretchThreadCount >= 0) { "Invalid stretch thread count" }
+
+        nativeHandle.set(
+            Native.create(
+                sampleRate = sampleRate,
+                channels = channels,
+                bufferFrames = bufferFrames,
+                stretchQuality = stretchQuality.ordinal,
+                blockSamples = blockSamples,
+                intervalSamples = intervalSamples,
+                speedMode = speedMode.ordinal,
+                resamplingInterpolator = resamplingInterpolator.ordinal,
+                stretchThreadCount = stretchThreadCount
+            )
+        )
 
         require(nativeHandle.get() != -1L) { "Could not instantiate native sampler" }
     }
 
+    fun getNativeHandle(): Long {
+        ensureOpen()
+
+        return nativeHandle.get()
+    }
+
     fun start() = runCatching {
         ensureOpen()
 
@@ -73,6 +126,21 @@ internal class NativeSampler(sampleRate: Int, channels: Int) : Closeable {
         )
     }
 
+    fun writePlanar(bytes: ByteArray, volume: Float, playbackSpeedFactor: Float) = runCatching {
+        ensureOpen()
+
+        require(volume in 0.0..1.0) { "Volume must be between 0.0 and 1.0" }
+
+        require(playbackSpeedFactor in 0.5..2.0) { "Playback speed factor must be between 0.5 and 2.0" }
+
+        Native.writePlanar(
+            handle = nativeHandle.get(),
+            bytes = bytes,
+            volume = volume,
+            playbackSpeedFactor = playbackSpeedFactor
+        )
+    }
+
     fun stop() = runCatching {
         ensureOpen()
 
@@ -95,5 +163,17 @@ internal class NativeSampler(sampleRate: Int, channels: Int) : Closeable {
         Native.drain(handle = nativeHandle.get(), volume = volume, playbackSpeedFactor = playbackSpeedFactor)
     }
 
+    fun getLatency() = runCatching {
+        ensureOpen()
+
+        Native.getLatency(handle = nativeHandle.get())
+    }
+
+    fun getUnderrunCount() = runCatching {
+        ensureOpen()
+
+        Native.getUnderrunCount(handle = nativeHandle.get())
+    }
+
     override fun close() = cleanable.clean()
 }
\ No newline at end of file
@@ -0,0 +1,6 @@
+package io.github.numq.klarity.sampler
+
+internal enum class NativeSpeedMode {
+    STRETCH,
+    RESAMPLE,
+}
\ No newline at end of file
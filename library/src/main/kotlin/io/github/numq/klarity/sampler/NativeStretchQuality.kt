@@ -0,0 +1,8 @@
+package io.github.numq.klarity.sampler
+
+internal enum class NativeStretchQuality {
+    DEFAULT,
+    CHEAP,
+    HIGH,
+    LOW_LATENCY,
+}
\ No newline at end of file
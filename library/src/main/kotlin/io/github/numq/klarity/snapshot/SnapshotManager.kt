@@ -1,9 +1,7 @@
 package io.github.numq.klarity.snapshot
 
 import io.github.numq.klarity.decoder.VideoDecoderFactory
-import io.github.numq.klarity.frame.Frame
 import io.github.numq.klarity.hwaccel.HardwareAcceleration
-import org.jetbrains.skia.Data
 import kotlin.time.Duration
 
 /**
@@ -16,6 +14,8 @@ object SnapshotManager {
      * @param location media file path or URI
      * @param hardwareAccelerationCandidates preferred hardware acceleration methods in order of priority
      * @param keyFramesOnly if `true`, seeks only to keyframes (faster but less precise)
+     * @param width snapshot width, or `null` to keep the video width
+     * @param height snapshot height, or `null` to keep the video height
      * @param timestamps a function that provides a media duration that can be used to construct desired timestamps
      *
      * @return [Result] containing a list of [Snapshot]. Each [Snapshot] must be closed by the caller
@@ -26,6 +26,8 @@ object SnapshotManager {
         location: String,
         hardwareAccelerationCandidates: List<HardwareAcceleration>? = null,
         keyFramesOnly: Boolean = true,
+        width: Int? = null,
+        height: Int? = null,
         timestamps: (duration: Duration) -> (List<Duration>) = { listOf(Duration.ZERO) },
     ): Result<List<Snapshot>> = VideoDecoderFactory().create(
         parameters = VideoDecoderFactory.Parameters(
@@ -34,39 +36,20 @@ object SnapshotManager {
     ).mapCatching { decoder ->
         val format = decoder.format
 
-        val frames = mutableListOf<Frame.Content.Video>()
-
         try {
-            timestamps(decoder.duration).filter {
-                it in Duration.ZERO..decoder.duration
-            }.forEach { timestamp ->
-                decoder.seekTo(timestamp = timestamp, keyFramesOnly = keyFramesOnly).getOrThrow()
-
-                var frame: Frame.Content.Video? = null
-
-                Data.makeUninitialized(format.bufferCapacity).let { data ->
-                    try {
-                        frame = (decoder.decodeVideo(data = data).getOrThrow() as? Frame.Content.Video)
-                    } finally {
-                        if (frame == null) {
-                            data.close()
-                        }
-                    }
-                }
+            val frames = decoder.decodeThumbnails(
+                timestamps = timestamps(decoder.duration).filter { it in Duration.ZERO..decoder.duration },
+                width = width ?: format.width,
+                height = height ?: format.height,
+                keyFramesOnly = keyFramesOnly
+            ).getOrThrow().filterNotNull()
 
-                frame?.let(frames::add)
+            frames.map { frame ->
+                Snapshot(format = format, frame = frame)
             }
-        } catch (t: Throwable) {
-            frames.forEach(Frame.Content.Video::close)
-
-            throw t
         } finally {
             decoder.close().getOrThrow()
         }
-
-        frames.map { frame ->
-            Snapshot(format = format, frame = frame)
-        }
     }.recoverCatching { t ->
         throw SnapshotManagerException(t)
     }
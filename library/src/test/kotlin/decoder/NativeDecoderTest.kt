@@ -2,14 +2,20 @@ package decoder
 
 import JNITest
 import io.github.numq.klarity.decoder.NativeDecoder
+import io.github.numq.klarity.decoder.NativeDecodingProfile
+import io.github.numq.klarity.decoder.NativeThreadType
+import io.github.numq.klarity.format.NativeAudioOutputFormat
+import io.github.numq.klarity.format.NativeVideoOutputFormat
 import kotlinx.coroutines.test.runTest
 import org.jetbrains.skia.Data
+import org.junit.jupiter.api.Assertions.assertEquals
 import org.junit.jupiter.api.Assertions.assertNotNull
 import org.junit.jupiter.api.Assertions.assertTrue
 import org.junit.jupiter.api.Test
 import org.junit.jupiter.api.assertThrows
 import java.io.File
 import java.net.URL
+import kotlin.time.Duration.Companion.milliseconds
 
 class NativeDecoderTest : JNITest() {
     private val files = File(ClassLoader.getSystemResources("files").nextElement().let(URL::getFile)).listFiles()
@@ -64,6 +70,331 @@ class NativeDecoderTest : JNITest() {
         decoder.close()
     }
 
+    @Test
+    fun `should decode interleaved audio and video from a single decoder`() = runTest {
+        val decoder = NativeDecoder(
+            location = mediaFile,
+            findAudioStream = true,
+            findVideoStream = true,
+            decodeAudioStream = true,
+            decodeVideoStream = true
+        )
+
+        val bufferSize = decoder.format.getOrThrow().videoBufferCapacity
+        val nativeBuffer = Data.makeUninitialized(bufferSize)
+
+        repeat(10) {
+            val audioFrame = decoder.decodeAudio().getOrThrow()
+            val videoFrame = decoder.decodeVideo(nativeBuffer.writableData(), bufferSize).getOrThrow()
+
+            assertNotNull(audioFrame)
+            assertNotNull(videoFrame)
+        }
+
+        nativeBuffer.close()
+        decoder.close()
+    }
+
+    @Test
+    fun `should decode ahead on a background thread`() = runTest {
+        val decoder = NativeDecoder(
+            location = mediaFile,
+            findAudioStream = true,
+            findVideoStream = true,
+            decodeAudioStream = true,
+            decodeVideoStream = true,
+            readAheadFrames = 8
+        )
+
+        val bufferSize = decoder.format.getOrThrow().videoBufferCapacity
+        val nativeBuffer = Data.makeUninitialized(bufferSize)
+
+        assertNotNull(decoder.decodeVideo(nativeBuffer.writableData(), bufferSize).getOrThrow())
+        assertNotNull(decoder.decodeAudio().getOrThrow())
+
+        assertTrue(decoder.seekTo(1_000_000, keyFramesOnly = false).isSuccess)
+
+        assertNotNull(decoder.decodeVideo(nativeBuffer.writableData(), bufferSize).getOrThrow())
+        assertNotNull(decoder.decodeAudio().getOrThrow())
+
+        nativeBuffer.close()
+        decoder.close()
+    }
+
+    @Test
+    fun `should decode video planes without colour conversion`() = runTest {
+        val decoder = NativeDecoder(
+            location = videoFile,
+            findAudioStream = false,
+            findVideoStream = true,
+            decodeAudioStream = false,
+            decodeVideoStream = true,
+            videoOutputFormat = NativeVideoOutputFormat.YUV
+        )
+
+        val format = decoder.format.getOrThrow()
+
+        assertEquals(format.width, format.videoStrides[0])
+
+        val nativeBuffer = Data.makeUninitialized(format.videoBufferCapacity)
+
+        val frame = decoder.decodeVideo(nativeBuffer.writableData(), format.videoBufferCapacity).getOrThrow()
+
+        assertNotNull(frame)
+        assertTrue(frame!!.remaining < format.width * format.height * 4)
+
+        nativeBuffer.close()
+        decoder.close()
+    }
+
+    @Test
+    fun `should scale video to the requested output size`() = runTest {
+        val decoder = NativeDecoder(
+            location = mediaFile,
+            findAudioStream = false,
+            findVideoStream = true,
+            decodeAudioStream = false,
+            decodeVideoStream = true
+        )
+
+        val sourceFormat = decoder.format.getOrThrow()
+
+        decoder.setOutputSize(sourceFormat.width / 2, sourceFormat.height / 2).getOrThrow()
+
+        val format = decoder.format.getOrThrow()
+
+        assertTrue(format.videoBufferCapacity < sourceFormat.videoBufferCapacity)
+
+        val nativeBuffer = Data.makeUninitialized(format.videoBufferCapacity)
+
+        val frame = decoder.decodeVideo(nativeBuffer.writableData(), format.videoBufferCapacity).getOrThrow()
+
+        assertNotNull(frame)
+        assertEquals(sourceFormat.width / 2, frame!!.width)
+        assertEquals(sourceFormat.height / 2, frame.height)
+        assertEquals(frame.width * frame.height * 4, frame.remaining)
+
+        assertTrue(decoder.setOutputSize(-1, 0).isFailure)
+
+        nativeBuffer.close()
+        decoder.close()
+    }
+
+    @Test
+    fun `should decode with explicit threading and throughput profile`() = runTest {
+        val decoder = NativeDecoder(
+            location = mediaFile,
+            findAudioStream = true,
+            findVideoStream = true,
+            decodeAudioStream = true,
+            decodeVideoStream = true,
+            threadCount = 4,
+            threadType = NativeThreadType.FRAME,
+            decodingProfile = NativeDecodingProfile.THROUGHPUT
+        )
+
+        val format = decoder.format.getOrThrow()
+
+        val nativeBuffer = Data.makeUninitialized(format.videoBufferCapacity)
+
+        repeat(10) {
+            assertNotNull(decoder.decodeVideo(nativeBuffer.writableData(), format.videoBufferCapacity).getOrThrow())
+        }
+
+        assertNotNull(decoder.decodeAudio().getOrThrow())
+
+        nativeBuffer.close()
+        decoder.close()
+    }
+
+    @Test
+    fun `should index keyframes and seek precisely`() = runTest {
+        val decoder = NativeDecoder(
+            location = mediaFile,
+            findAudioStream = false,
+            findVideoStream = true,
+            decodeAudioStream = false,
+            decodeVideoStream = true
+        )
+
+        val keyframes = decoder.getKeyframes().getOrThrow()
+
+        assertTrue(keyframes.isNotEmpty())
+        assertTrue(keyframes.zipWithNext().all { (a, b) -> a.timestampMicros < b.timestampMicros })
+
+        val format = decoder.format.getOrThrow()
+
+        val nativeBuffer = Data.makeUninitialized(format.videoBufferCapacity)
+
+        val target = format.durationMicros / 2
+
+        assertTrue(decoder.seekTo(target, keyFramesOnly = false).isSuccess)
+
+        val frame = decoder.decodeVideo(nativeBuffer.writableData(), format.videoBufferCapacity).getOrThrow()
+
+        assertNotNull(frame)
+        assertTrue(frame!!.timestampMicros >= keyframes.last { it.timestampMicros <= target }.timestampMicros)
+
+        nativeBuffer.close()
+        decoder.close()
+    }
+
+    @Test
+    fun `should decode thumbnails into a single buffer`() = runTest {
+        val decoder = NativeDecoder(
+            location = mediaFile,
+            findAudioStream = false,
+            findVideoStream = true,
+            decodeAudioStream = false,
+            decodeVideoStream = true
+        )
+
+        val format = decoder.format.getOrThrow()
+
+        val timestamps = LongArray(8) { index -> format.durationMicros * (7 - index) / 8 }
+
+        val thumbnailSize = 64 * 36 * 4
+
+        val nativeBuffer = Data.makeUninitialized(thumbnailSize * timestamps.size)
+
+        val thumbnails = decoder.decodeThumbnails(
+            timestampsMicros = timestamps,
+            width = 64,
+            height = 36,
+            keyFramesOnly = false,
+            buffer = nativeBuffer.writableData(),
+            capacity = nativeBuffer.size
+        ).getOrThrow()
+
+        assertEquals(timestamps.size, thumbnails.size)
+        assertTrue(thumbnails.all { thumbnail -> thumbnail?.remaining == thumbnailSize })
+        assertEquals(format.videoBufferCapacity, decoder.format.getOrThrow().videoBufferCapacity)
+
+        nativeBuffer.close()
+        decoder.close()
+    }
+
+    @Test
+    fun `should decode audio into a native buffer`() = runTest {
+        val decoder = NativeDecoder(
+            location = audioFile,
+            findAudioStream = true,
+            findVideoStream = false,
+            decodeAudioStream = true,
+            decodeVideoStream = false
+        )
+
+        val format = decoder.format.getOrThrow()
+
+        assertTrue(format.audioBufferCapacity > 0)
+
+        val nativeBuffer = Data.makeUninitialized(format.audioBufferCapacity)
+
+        val chunk = decoder.decodeAudio(nativeBuffer.writableData(), format.audioBufferCapacity).getOrThrow()
+
+        assertNotNull(chunk)
+        assertTrue(chunk!!.remaining in 1..format.audioBufferCapacity)
+        assertEquals(0, chunk.remaining % (format.channels * Float.SIZE_BYTES))
+
+        assertTrue(decoder.decodeAudio(nativeBuffer.writableData(), 1).isFailure)
+
+        nativeBuffer.close()
+        decoder.close()
+    }
+
+    @Test
+    fun `should batch decoded audio into fixed size chunks`() = runTest {
+        val decoder = NativeDecoder(
+            location = audioFile,
+            findAudioStream = true,
+            findVideoStream = false,
+            decodeAudioStream = true,
+            decodeVideoStream = false
+        )
+
+        decoder.setAudioChunkDuration(100.milliseconds).getOrThrow()
+
+        val format = decoder.format.getOrThrow()
+
+        val chunkSamples = format.sampleRate / 10
+
+        val chunkSize = chunkSamples * format.channels * Float.SIZE_BYTES
+
+        assertTrue(format.audioBufferCapacity >= chunkSize)
+
+        val nativeBuffer = Data.makeUninitialized(format.audioBufferCapacity)
+
+        val first = decoder.decodeAudio(nativeBuffer.writableData(), format.audioBufferCapacity).getOrThrow()
+
+        val second = decoder.decodeAudio(nativeBuffer.writableData(), format.audioBufferCapacity).getOrThrow()
+
+        assertNotNull(first)
+        assertNotNull(second)
+        assertEquals(chunkSize, first!!.remaining)
+        assertEquals(chunkSize, second!!.remaining)
+        assertTrue(second.timestampMicros - first.timestampMicros in 99_000L..101_000L)
+
+        nativeBuffer.close()
+        decoder.close()
+    }
+
+    @Test
+    fun `should convert audio to the requested rate, layout and format`() = runTest {
+        val decoder = NativeDecoder(
+            location = audioFile,
+            findAudioStream = true,
+            findVideoStream = false,
+            decodeAudioStream = true,
+            decodeVideoStream = false,
+            outputSampleRate = 48_000,
+            outputChannels = 1,
+            audioOutputFormat = NativeAudioOutputFormat.S16
+        )
+
+        val format = decoder.format.getOrThrow()
+
+        assertEquals(48_000, format.sampleRate)
+        assertEquals(1, format.channels)
+
+        val nativeBuffer = Data.makeUninitialized(format.audioBufferCapacity)
+
+        val chunk = decoder.decodeAudio(nativeBuffer.writableData(), format.audioBufferCapacity).getOrThrow()
+
+        assertNotNull(chunk)
+        assertEquals(0, chunk!!.remaining % Short.SIZE_BYTES)
+
+        nativeBuffer.close()
+        decoder.close()
+    }
+
+    @Test
+    fun `should size the audio buffer for more output channels than the source`() = runTest {
+        val decoder = NativeDecoder(
+            location = audioFile,
+            findAudioStream = true,
+            findVideoStream = false,
+            decodeAudioStream = true,
+            decodeVideoStream = false,
+            outputChannels = 8
+        )
+
+        val format = decoder.format.getOrThrow()
+
+        assertEquals(8, format.channels)
+
+        val nativeBuffer = Data.makeUninitialized(format.audioBufferCapacity)
+
+        repeat(10) {
+            val chunk = decoder.decodeAudio(nativeBuffer.writableData(), format.audioBufferCapacity).getOrThrow()
+
+            assertNotNull(chunk)
+            assertEquals(0, chunk!!.remaining % (format.channels * Float.SIZE_BYTES))
+        }
+
+        nativeBuffer.close()
+        decoder.close()
+    }
+
     @Test
     fun `should seek and reset without failure`() = runTest {
         val decoder = NativeDecoder(
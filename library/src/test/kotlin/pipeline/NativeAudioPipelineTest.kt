@@ -0,0 +1,63 @@
+package pipeline
+
+import JNITest
+import io.github.numq.klarity.decoder.NativeDecoder
+import io.github.numq.klarity.pipeline.NativeAudioPipeline
+import io.github.numq.klarity.sampler.NativeSampler
+import kotlinx.coroutines.delay
+import kotlinx.coroutines.runBlocking
+import org.junit.jupiter.api.Assertions.assertEquals
+import org.junit.jupiter.api.Assertions.assertTrue
+import org.junit.jupiter.api.Test
+import java.io.File
+import java.net.URL
+
+class NativeAudioPipelineTest : JNITest() {
+    private val files = File(ClassLoader.getSystemResources("files").nextElement().let(URL::getFile)).listFiles()
+
+    private val audioFile = files?.find { file -> file.nameWithoutExtension == "audio_only" }?.absolutePath!!
+
+    @Test
+    fun `should play seek and report the playback clock`() = runBlocking {
+        val decoder = NativeDecoder(
+            location = audioFile,
+            findAudioStream = true,
+            findVideoStream = false,
+            decodeAudioStream = true,
+            decodeVideoStream = false
+        )
+
+        val format = decoder.format.getOrThrow()
+
+        val sampler = NativeSampler(sampleRate = format.sampleRate, channels = format.channels)
+
+        val pipeline = NativeAudioPipeline(decoder = decoder, sampler = sampler)
+
+        assertTrue(pipeline.setVolume(0f).isSuccess)
+        assertTrue(pipeline.setPlaybackSpeed(1.5f).isSuccess)
+        assertTrue(pipeline.start().isSuccess)
+
+        delay(500L)
+
+        assertTrue(pipeline.stop().isSuccess)
+
+        val timestampMicros = pipeline.getTimestampMicros().getOrThrow()
+
+        assertTrue(timestampMicros > 0L)
+
+        delay(100L)
+
+        assertEquals(timestampMicros, pipeline.getTimestampMicros().getOrThrow())
+
+        assertTrue(pipeline.seekTo(1_000_000L).isSuccess)
+        assertEquals(1_000_000L, pipeline.getTimestampMicros().getOrThrow())
+        assertTrue(pipeline.isCompleted().getOrThrow().not())
+
+        assertTrue(pipeline.setPlaybackSpeed(3f).isFailure)
+
+        pipeline.close()
+
+        assertTrue(sampler.stop().isFailure)
+        assertTrue(decoder.getKeyframes().isFailure)
+    }
+}
@@ -2,9 +2,14 @@ package sampler
 
 import JNITest
 import io.github.numq.klarity.sampler.NativeSampler
+import io.github.numq.klarity.sampler.NativeResamplingInterpolator
+import io.github.numq.klarity.sampler.NativeSpeedMode
+import io.github.numq.klarity.sampler.NativeStretchQuality
 import kotlinx.coroutines.test.runTest
 import org.junit.jupiter.api.Test
 import org.junit.jupiter.api.assertThrows
+import kotlin.concurrent.thread
+import kotlin.system.measureTimeMillis
 
 class NativeSamplerTest : JNITest() {
 
@@ -13,6 +18,16 @@ class NativeSamplerTest : JNITest() {
         NativeSampler(sampleRate = 44100, channels = 2).close()
     }
 
+    @Test
+    fun `should close a running sampler without stopping it`() = runTest {
+        val sampler = NativeSampler(sampleRate = 48000, channels = 2)
+
+        assert(sampler.start().isSuccess)
+        assert(sampler.write(ByteArray(1024 * 2 * Float.SIZE_BYTES), 0f, 1f).isSuccess)
+
+        sampler.close()
+    }
+
     @Test
     fun `should start write and stop playback`() = runTest {
         val sampler = NativeSampler(sampleRate = 48000, channels = 2)
@@ -28,6 +43,194 @@ class NativeSamplerTest : JNITest() {
         sampler.close()
     }
 
+    @Test
+    fun `should write planar samples`() = runTest {
+        val sampler = NativeSampler(sampleRate = 48000, channels = 2)
+
+        val startResult = sampler.start()
+        val writeResult = sampler.writePlanar(ByteArray(1024), 1f, 1f)
+        val stopResult = sampler.stop()
+
+        assert(startResult.isSuccess)
+        assert(writeResult.isSuccess)
+        assert(stopResult.isSuccess)
+
+        sampler.close()
+    }
+
+    @Test
+    fun `should buffer writes and count underruns`() = runTest {
+        val sampler = NativeSampler(sampleRate = 48000, channels = 2, bufferFrames = 4800)
+
+        assert(sampler.start().isSuccess)
+
+        repeat(10) {
+            assert(sampler.write(ByteArray(48000 * 2 * Float.SIZE_BYTES / 100), 0f, 1f).isSuccess)
+        }
+
+        Thread.sleep(300L)
+
+        val underruns = sampler.getUnderrunCount()
+
+        assert(sampler.stop().isSuccess)
+        assert(underruns.isSuccess)
+        assert(underruns.getOrThrow() > 0L)
+
+        sampler.close()
+    }
+
+    @Test
+    fun `should switch between passthrough and time stretching`() = runTest {
+        val sampler = NativeSampler(sampleRate = 48000, channels = 2)
+
+        val bytes = ByteArray(1024 * 2 * Float.SIZE_BYTES)
+
+        assert(sampler.start().isSuccess)
+
+        listOf(1f, 1f, 1.5f, 1.5f, 1f, 0.75f, 1f).forEach { playbackSpeedFactor ->
+            assert(sampler.write(bytes, 0f, playbackSpeedFactor).isSuccess)
+        }
+
+        assert(sampler.drain(0f, 1f).isSuccess)
+
+        sampler.close()
+    }
+
+    @Test
+    fun `should stretch with every quality tier`() = runTest {
+        val bytes = ByteArray(1024 * 2 * Float.SIZE_BYTES)
+
+        NativeStretchQuality.entries.forEach { stretchQuality ->
+            val sampler = NativeSampler(sampleRate = 48000, channels = 2, stretchQuality = stretchQuality)
+
+            assert(sampler.start().isSuccess)
+            assert(sampler.write(bytes, 0f, 1.5f).isSuccess)
+            assert(sampler.stop().isSuccess)
+
+            sampler.close()
+        }
+    }
+
+    @Test
+    fun `should report lower latency for a smaller custom stretch block`() = runTest {
+        val bytes = ByteArray(1024 * 2 * Float.SIZE_BYTES)
+
+        val latencies = listOf(9600 to 1440, 2048 to 512).map { (blockSamples, intervalSamples) ->
+            val sampler = NativeSampler(
+                sampleRate = 48000,
+                channels = 2,
+                blockSamples = blockSamples,
+                intervalSamples = intervalSamples
+            )
+
+            assert(sampler.start().isSuccess)
+            assert(sampler.write(bytes, 0f, 1.5f).isSuccess)
+
+            val latency = sampler.getLatency().getOrThrow()
+
+            assert(sampler.stop().isSuccess)
+
+            sampler.close()
+
+            latency
+        }
+
+        assert(latencies[1] < latencies[0])
+    }
+
+    @Test
+    fun `should include stretch latency once time stretching is active`() = runTest {
+        val bytes = ByteArray(1024 * 2 * Float.SIZE_BYTES)
+
+        val sampler = NativeSampler(sampleRate = 48000, channels = 2)
+
+        val bypassLatency = sampler.start().getOrThrow()
+
+        assert(sampler.write(bytes, 0f, 1.5f).isSuccess)
+
+        val stretchLatency = sampler.getLatency().getOrThrow()
+
+        assert(sampler.write(bytes, 0f, 1f).isSuccess)
+
+        assert(stretchLatency > bypassLatency)
+        assert(sampler.getLatency().getOrThrow() == bypassLatency)
+        assert(sampler.stop().isSuccess)
+
+        sampler.close()
+    }
+
+    @Test
+    fun `should change speed by resampling with every interpolator`() = runTest {
+        val bytes = ByteArray(1024 * 2 * Float.SIZE_BYTES)
+
+        NativeResamplingInterpolator.entries.forEach { resamplingInterpolator ->
+            val sampler = NativeSampler(
+                sampleRate = 48000,
+                channels = 2,
+                speedMode = NativeSpeedMode.RESAMPLE,
+                resamplingInterpolator = resamplingInterpolator
+            )
+
+            assert(sampler.start().isSuccess)
+
+            listOf(1f, 2f, 0.5f, 1f).forEach { playbackSpeedFactor ->
+                assert(sampler.write(bytes, 0f, playbackSpeedFactor).isSuccess)
+            }
+
+            assert(sampler.stop().isSuccess)
+
+            sampler.close()
+        }
+    }
+
+    @Test
+    fun `should stretch multichannel audio in parallel`() = runTest {
+        val bytes = ByteArray(1024 * 6 * Float.SIZE_BYTES)
+
+        listOf(0, 2).forEach { stretchThreadCount ->
+            val sampler = NativeSampler(sampleRate = 48000, channels = 6, stretchThreadCount = stretchThreadCount)
+
+            assert(sampler.start().isSuccess)
+
+            listOf(2f, 0.5f, 1.5f).forEach { playbackSpeedFactor ->
+                assert(sampler.write(bytes, 0f, playbackSpeedFactor).isSuccess)
+            }
+
+            assert(sampler.stop().isSuccess)
+
+            sampler.close()
+        }
+    }
+
+    @Test
+    fun `should keep the rest of a write interrupted by stop`() = runTest {
+        val sampler = NativeSampler(sampleRate = 48000, channels = 2, bufferFrames = 4800)
+
+        val bytes = ByteArray(48000 * 2 * Float.SIZE_BYTES)
+
+        assert(sampler.start().isSuccess)
+
+        val writer = thread {
+            assert(sampler.write(bytes, 0f, 1f).isSuccess)
+        }
+
+        Thread.sleep(100L)
+
+        assert(sampler.stop().isSuccess)
+
+        writer.join()
+
+        assert(sampler.start().isSuccess)
+
+        val drainMillis = measureTimeMillis {
+            assert(sampler.drain(0f, 1f).isSuccess)
+        }
+
+        assert(drainMillis >= 500L)
+
+        sampler.close()
+    }
+
     @Test
     fun `should flush and drain without error`() = runTest {
         val sampler = NativeSampler(sampleRate = 44100, channels = 2)
@@ -50,5 +253,9 @@ class NativeSamplerTest : JNITest() {
         assertThrows<IllegalArgumentException> {
             NativeSampler(sampleRate = 44100, channels = 0)
         }
+
+        assertThrows<IllegalArgumentException> {
+            NativeSampler(sampleRate = 44100, channels = 2, stretchThreadCount = -1)
+        }
     }
 }